@@ -7,6 +7,7 @@
 #include <stdbool.h>
 #include <stddef.h>
 #include <assert.h>
+#include "saferotp_ecc.h" // SAFEROTP_ECC_DECODE_DETAILS
 
 #ifdef __cplusplus
 extern "C" {
@@ -46,6 +47,16 @@ bool saferotp_virtualization_restore(uint16_t starting_row, const void* buffer,
 /// @return true if the virtualized OTP rows were successfully retrieved.
 bool saferotp_virtualization_save(uint16_t starting_row, void* buffer, size_t buffer_size);
 #pragma endregion // OTP Virtualization support
+#pragma region    // Raw row cache
+/// @brief Discards every row held by the optional raw row cache (see SAFEROTP_RAW_ROW_CACHE_BLOCKS),
+///        so the next read of each row goes to the OTP.  Writes through this library already
+///        invalidate the rows written; call this if the OTP may have changed by other means
+///        (e.g., written directly via the bootrom, or to re-check marginal rows).
+///        Not needed after locking a page: cached rows are only returned while the page's
+///        SW_LOCK register still allows secure reads.
+///        Does nothing when the cache is disabled.
+void saferotp_flush_raw_row_cache(void);
+#pragma endregion // Raw row cache
 #pragma region    // OTP Read / Write functions
 
 // RP2350 OTP can encode data in multiple ways:
@@ -96,6 +107,9 @@ bool saferotp_read_single_value_ecc(uint16_t row, uint16_t* out_data);
 // Allows writing an odd number of bytes, so caller does not have to
 // do extra work to ensure buffer is always an even number of bytes.
 // In this case, the extra byte written will be zero.
+// The entire range is read and planned first: if any row cannot be written,
+// nothing is written.  Changed rows are then programmed in contiguous runs,
+// and verified with bulk reads.
 // Returns false unless all data is written and verified.
 bool saferotp_write_data_ecc(uint16_t start_row, const void* data, size_t count_of_bytes);
 // `ECC` - Fills the supplied buffer with ECC data, starting at the specified
@@ -104,6 +118,35 @@ bool saferotp_write_data_ecc(uint16_t start_row, const void* data, size_t count_
 // do extra work to ensure buffer is always an even number of bytes.
 // Returns false unless all requested data is read.
 bool saferotp_read_data_ecc(uint16_t start_row, void* out_data, size_t count_of_bytes);
+// `ECC` - Reads `row_count` consecutive OTP rows, starting at the specified
+// OTP row, and fills one SAFEROTP_ECC_DECODE_DETAILS per row (decoded value,
+// clean / corrected / error, flipped bit index, BRBP polarity).
+// All rows are always reported, even when some rows fail; rows that could
+// not be read are reported as SAFEROTP_ECC_ROW_STATUS_READ_FAILED.
+// Returns false unless every row was read and decoded successfully.
+bool saferotp_read_data_ecc_with_details(uint16_t start_row, SAFEROTP_ECC_DECODE_DETAILS* out_details, size_t row_count);
+// `ECC` - Reads a key (e.g., 128-bit or 256-bit) stored as ECC data, starting at the
+// specified OTP row.  Intended for secure-boot paths: the whole range is fetched with
+// a single raw access (bypassing the raw row cache), and all rows are decoded without
+// data-dependent branches.
+// `count_of_bytes` must be even, and at most 128 bytes (64 rows).
+// Reports a single aggregate status; on failure, the output buffer is zeroed.
+// Returns false unless every row of the key was read and decoded.
+bool saferotp_read_key_ecc(uint16_t start_row, void* out_key, size_t count_of_bytes);
+
+// `ECC_RS` - Writes the supplied buffer as ECC data (16 bits per row), starting at the
+// specified OTP row, followed by `parity_rows` Reed-Solomon parity rows (also ECC encoded).
+// Uses (count_of_bytes + 1) / 2 + parity_rows rows, which must fit in one OTP page (64 rows).
+// `parity_rows` must be 1..8.  Odd byte counts are padded with a zero byte.
+// There is no OTP directory entry type for this encoding: the caller tracks the layout.
+// Returns false unless all data and parity rows are written and verified.
+bool saferotp_write_data_ecc_rs(uint16_t start_row, const void* data, size_t count_of_bytes, uint8_t parity_rows);
+// `ECC_RS` - Reads data written by saferotp_write_data_ecc_rs().
+// Each row still corrects single-bit errors using ECC.  Rows that fail to read or decode
+// are treated as erasures, and up to `parity_rows` of them are rebuilt from the parity rows.
+// Parity rows not needed for rebuilding are used to verify the result.
+// Returns false unless all requested data is read (or rebuilt) and verified.
+bool saferotp_read_data_ecc_rs(uint16_t start_row, void* out_data, size_t count_of_bytes, uint8_t parity_rows);
 
 // `BYTE3X` - Writes a single OTP row with 8-bits of data stored with 3x redundancy.
 // For each bit of the new value that is zero:
@@ -120,8 +163,15 @@ bool saferotp_write_single_value_byte3x(uint16_t row, uint8_t new_value);
 // Returns false unless all requested data is read.
 bool saferotp_read_single_value_byte3x(uint16_t row, uint8_t* out_data);
 
-// TODO: add `saferotp_write_data_byte3x(uint16_t start_row, const void* data, size_t count_of_bytes);`
-// TODO: add `saferotp_read_data_byte3x(uint16_t start_row, void* out_data, size_t count_of_bytes);`
+// `BYTE3X` - Writes the supplied buffer to OTP, one byte per OTP row (stored with 3x redundancy),
+// starting at the specified OTP row.  The entire range is checked before anything is written;
+// rows are written in contiguous runs, and verified (with voting applied) with bulk reads.
+// Returns false unless all data is written and verified (with voting applied).
+bool saferotp_write_data_byte3x(uint16_t start_row, const void* data, size_t count_of_bytes);
+// `BYTE3X` - Fills the supplied buffer, one byte per OTP row, after applying 2-of-3 voting.
+// Reads the range with as few bootrom calls as possible.
+// Returns false unless all requested data is read.
+bool saferotp_read_data_byte3x(uint16_t start_row, void* out_data, size_t count_of_bytes);
 
 // `RBIT3` - Writes three consecutive rows of OTP data with same 24-bit data.
 // For each bit with a new value of zero:
@@ -139,8 +189,18 @@ bool saferotp_write_single_value_rbit3(uint16_t start_row, uint32_t new_value);
 // Returns false unless all requested data is read.
 bool saferotp_read_single_value_rbit3(uint16_t start_row, uint32_t* out_data);
 
-// TODO: add `saferotp_write_data_rbit3(uint16_t start_row, const void* data, size_t count_of_bytes);`
-// TODO: add `saferotp_read_data_rbit3(uint16_t start_row, void* out_data, size_t count_of_bytes);`
+// `RBIT3` - Writes the supplied buffer of 24-bit values (one uint32_t per 3 rows),
+// starting at the specified OTP row.  Each value follows the same rules as
+// saferotp_write_single_value_rbit3().  The entire range is checked before anything
+// is written; rows are written in contiguous runs, and verified with bulk reads.
+// `count_of_bytes` must be a non-zero multiple of four.
+// Returns false unless all data is written and verified (with voting applied).
+bool saferotp_write_data_rbit3(uint16_t start_row, const void* data, size_t count_of_bytes);
+// `RBIT3` - Fills the supplied buffer with 24-bit values (one uint32_t per 3 rows),
+// applying 2-of-3 voting to each group of rows.  Each row is read only once.
+// `count_of_bytes` must be a non-zero multiple of four.
+// Returns false unless all requested data is read.
+bool saferotp_read_data_rbit3(uint16_t start_row, void* out_data, size_t count_of_bytes);
 
 // `RBIT8` - Writes eight consecutive rows of OTP data with same 24-bit data.
 // For each bit with a new value of zero:
@@ -158,8 +218,166 @@ bool saferotp_write_single_value_rbit8(uint16_t start_row, uint32_t new_value);
 // Returns false unless all requested data is read.
 bool saferotp_read_single_value_rbit8(uint16_t start_row, uint32_t* out_data);
 
-// TODO: add `saferotp_write_data_rbit8(uint16_t start_row, const void* data, size_t count_of_bytes);`
-// TODO: add `saferotp_read_data_rbit8(uint16_t start_row, void* out_data, size_t count_of_bytes);`
+// `RBIT8` - Writes the supplied buffer of 24-bit values (one uint32_t per 8 rows),
+// starting at the specified OTP row.  Each value follows the same rules as
+// saferotp_write_single_value_rbit8().  The entire range is checked before anything
+// is written; rows are written in contiguous runs, and verified with bulk reads.
+// `count_of_bytes` must be a non-zero multiple of four.
+// Returns false unless all data is written and verified (with voting applied).
+bool saferotp_write_data_rbit8(uint16_t start_row, const void* data, size_t count_of_bytes);
+// `RBIT8` - Fills the supplied buffer with 24-bit values (one uint32_t per 8 rows),
+// applying 3-of-8 voting to each group of rows.  Each row is read only once.
+// `count_of_bytes` must be a non-zero multiple of four.
+// Returns false unless all requested data is read.
+bool saferotp_read_data_rbit8(uint16_t start_row, void* out_data, size_t count_of_bytes);
+
+// Per-row outcome reported by the `_ext` bulk functions (one uint8_t per OTP row).
+// Unlike the other bulk functions, the `_ext` functions process the entire range,
+// even after a row fails, so callers can retry / repair only the rows that failed.
+typedef enum _SAFEROTP_ROW_STATUS {
+    SAFEROTP_ROW_STATUS_OK                 = 0,
+    SAFEROTP_ROW_STATUS_CORRECTED          = 1, // ECC: data is correct, but a single bit error was corrected
+    SAFEROTP_ROW_STATUS_UNDECODABLE        = 2, // ECC: row was read, but is not valid ECC data
+    SAFEROTP_ROW_STATUS_WRITE_INCOMPATIBLE = 3, // existing bits prevent writing the new value (row was not written)
+    SAFEROTP_ROW_STATUS_IO_ERROR           = 4, // row could not be read or written (or the write did not take effect)
+} SAFEROTP_ROW_STATUS;
+
+// `ECC` - Same as saferotp_read_data_ecc(), but every row is read, and `out_row_status`
+// (one entry per row, (count_of_bytes + 1) / 2 entries) receives the outcome of each row.
+// Rows that fail are stored as 0xFFFF in the buffer.
+// Returns false unless every row is SAFEROTP_ROW_STATUS_OK or SAFEROTP_ROW_STATUS_CORRECTED.
+bool saferotp_read_data_ecc_ext(uint16_t start_row, void* out_data, size_t count_of_bytes, uint8_t* out_row_status);
+// `ECC` - Same as saferotp_write_data_ecc(), except that every row that can be written
+// is written (and verified), even if other rows of the range cannot be.
+// `out_row_status` (one entry per row) receives the outcome of each row;
+// SAFEROTP_ROW_STATUS_CORRECTED means the row verified, but without full ECC redundancy.
+// Returns false unless every row is SAFEROTP_ROW_STATUS_OK or SAFEROTP_ROW_STATUS_CORRECTED.
+bool saferotp_write_data_ecc_ext(uint16_t start_row, const void* data, size_t count_of_bytes, uint8_t* out_row_status);
+// `RAW` - Same as saferotp_read_data_raw_unsafe(), but every row is read, and `out_row_status`
+// (one entry per row, count_of_bytes / 4 entries) receives the outcome of each row.
+// Rows that fail to read are stored as 0xFFFFFFFF in the buffer.
+// Returns false unless every row is SAFEROTP_ROW_STATUS_OK.
+bool saferotp_read_data_raw_unsafe_ext(uint16_t start_row, void* out_data, size_t count_of_bytes, uint8_t* out_row_status);
+
+// Encodings supported by the scatter / gather functions (saferotp_readv() / saferotp_writev()).
+typedef enum _SAFEROTP_IOV_ENCODING {
+    SAFEROTP_IOV_ENCODING_RAW    = 0, // one uint32_t per row           (same as saferotp_read_data_raw_unsafe())
+    SAFEROTP_IOV_ENCODING_ECC    = 1, // two bytes per row, odd allowed (same as saferotp_read_data_ecc())
+    SAFEROTP_IOV_ENCODING_BYTE3X = 2, // one byte per row               (same as saferotp_read_data_byte3x())
+    SAFEROTP_IOV_ENCODING_RBIT3  = 3, // one uint32_t per three rows    (same as saferotp_read_data_rbit3())
+    SAFEROTP_IOV_ENCODING_RBIT8  = 4, // one uint32_t per eight rows    (same as saferotp_read_data_rbit8())
+} SAFEROTP_IOV_ENCODING;
+// Per-descriptor result of saferotp_readv() / saferotp_writev().
+typedef enum _SAFEROTP_IOV_STATUS {
+    SAFEROTP_IOV_STATUS_OK               = 0,
+    SAFEROTP_IOV_STATUS_INVALID          = 1, // unknown encoding, bad size / row range, or (writev) overlaps another descriptor
+    SAFEROTP_IOV_STATUS_READ_FAILED      = 2, // rows could not be read, decoded, or voted upon
+    SAFEROTP_IOV_STATUS_WRITE_IMPOSSIBLE = 3, // (writev) existing bits prevent writing the new data
+    SAFEROTP_IOV_STATUS_WRITE_FAILED     = 4, // (writev) writing or verifying the new data failed
+    SAFEROTP_IOV_STATUS_NOT_ATTEMPTED    = 5, // (writev) not written, because another descriptor failed
+} SAFEROTP_IOV_STATUS;
+// One field for saferotp_readv() / saferotp_writev().
+typedef struct _SAFEROTP_IOV {
+    void*    buffer;         // readv: destination; writev: source (not modified)
+    size_t   count_of_bytes; // same rules as the saferotp_read_data_xxx() function for the encoding
+    uint16_t start_row;
+    uint8_t  encoding;       // SAFEROTP_IOV_ENCODING
+    uint8_t  status;         // SAFEROTP_IOV_STATUS ... set by readv / writev
+} SAFEROTP_IOV;
+
+// Scatter / gather read of `iov_count` fields, each with its own row range and encoding.
+// Descriptors may be in any order, and may even overlap.  The rows of all the fields
+// are read together, merging adjacent / overlapping ranges so that each contiguous span
+// of rows is fetched with as few raw accesses as possible (one per page of rows).
+// Each field is then decoded with its own encoding, and its `status` set.
+// On failure, the contents of that field's buffer are undefined.
+// Returns false unless every field was read successfully.
+bool saferotp_readv(SAFEROTP_IOV* iov, size_t iov_count);
+// Scatter / gather write of `iov_count` fields.  Descriptors may not overlap.
+// Every field is read and planned (as the single-range write functions do)
+// before anything is written; if any field cannot be written, nothing is written.
+// Each field is then written and verified, stopping at the first failure.
+// Returns false unless every field was written and verified.
+bool saferotp_writev(SAFEROTP_IOV* iov, size_t iov_count);
+
+// Transactions: stage writes of any encoding, then commit them together.
+// Commit checks every operation against a single sweep of the affected rows, and
+// if any operation cannot be written (or any add failed), nothing is written.
+// Otherwise, all rows are programmed in row order (runs of rows coalesced across
+// operations), then every operation is verified with a single sweep.
+// The data buffers must remain valid (and unchanged) until commit returns.
+#define SAFEROTP_TXN_MAX_OPS (16u)
+typedef struct _SAFEROTP_TXN {
+    SAFEROTP_IOV ops[SAFEROTP_TXN_MAX_OPS]; // after commit, each op's `status` is set (as for writev)
+    uint8_t      op_count;
+    bool         add_failed;
+} SAFEROTP_TXN;
+void saferotp_txn_begin(SAFEROTP_TXN* txn);
+// `encoding` is a SAFEROTP_IOV_ENCODING; `data` / `count_of_bytes` follow the same
+// rules as the matching saferotp_write_data_xxx() function.  Operations may not overlap.
+// Returns false (and the transaction will not commit) if the operation is not valid.
+bool saferotp_txn_add(SAFEROTP_TXN* txn, uint8_t encoding, uint16_t start_row, const void* data, size_t count_of_bytes);
+// Returns false unless every operation was written and verified.
+bool saferotp_txn_commit(SAFEROTP_TXN* txn);
+
+// Asynchronous writes: saferotp_async_write() only queues the write, and returns at once.
+// Each call to saferotp_poll() then does one bounded step of the oldest queued write:
+// the first step checks the whole write (nothing is burned if it cannot be written),
+// and each later step programs and verifies only a few rows.  When a write completes,
+// its callback is called (from within saferotp_poll()) with its SAFEROTP_IOV_STATUS.
+// Writes may be queued from either core (or from a callback); saferotp_poll() is meant to
+// be called from one core (e.g., core1).  Concurrent calls (e.g., two RTOS tasks) are safe:
+// only one of them does a step.  SAFEROTP_ASYNC_QUEUE_DEPTH is a power of two.
+// The data buffer must remain valid (and unchanged) until the callback is called.
+#define SAFEROTP_ASYNC_QUEUE_DEPTH    (8u)
+#define SAFEROTP_ASYNC_INVALID_HANDLE (0u)
+typedef uint16_t SAFEROTP_ASYNC_HANDLE;
+typedef void (*SAFEROTP_ASYNC_CALLBACK)(SAFEROTP_ASYNC_HANDLE handle, uint8_t status, void* context);
+// `encoding` is a SAFEROTP_IOV_ENCODING; `data` / `count_of_bytes` follow the same
+// rules as the matching saferotp_write_data_xxx() function.  `callback` may be NULL.
+// Returns SAFEROTP_ASYNC_INVALID_HANDLE if the write is not valid, or the queue is full.
+SAFEROTP_ASYNC_HANDLE saferotp_async_write(uint8_t encoding, uint16_t start_row, const void* data, size_t count_of_bytes, SAFEROTP_ASYNC_CALLBACK callback, void* context);
+// Does one bounded step of queued work.  Returns true if more work remains queued.
+// Never waits for the other core: if it holds the write lock (a write is in progress,
+// or see saferotp_lock_acquire()), no work is done, and the step is left for a later call.
+bool saferotp_poll(void);
+
+// Explicit locking, for callers that need a bounded worst-case latency.
+// saferotp_lock_acquire() takes the library's write lock, retrying with exponential
+// backoff until `timeout_us` expires (0 == try only once).  While the caller holds it,
+// its writes never wait, so a bulk operation is locked once rather than per chunk.
+// Writes from the other core wait until saferotp_lock_release(), so hold the lock only
+// briefly.  Reads never take this lock.  The bootrom's OTP lock (BOOTLOCK2) is not held:
+// it is taken per bootrom call, so other users of the bootrom are never blocked by it.
+// Ownership follows the SDK's lock_get_caller_owner_id(): per core on bare metal, so two
+// RTOS tasks on the same core share ownership (either may release it), unless the RTOS
+// port provides per-task owner ids (e.g. FreeRTOS with configSUPPORT_PICO_SYNC_INTEROP).
+// Not for use from interrupt handlers.
+//
+// Worst case, while the caller holds the lock:
+//   * saferotp_lock_acquire() itself waits at most `timeout_us` (plus one attempt);
+//   * each bootrom call (read or write) made for the caller waits at most `timeout_us`
+//     for BOOTLOCK2, which another user (e.g., the other core in the bootrom) may hold for
+//     the duration of one of its own bootrom calls, plus the duration of the call itself.
+// So an operation costs at most (its bootrom calls) x (`timeout_us` + one bootrom call);
+// e.g., an ECC write of up to 64 readable rows makes 3 bootrom calls.  If BOOTLOCK2 is still
+// held after `timeout_us`, the operation fails (returns false), and saferotp_lock_last_status()
+// returns SAFEROTP_LOCK_STATUS_BUSY.  Without this lock, each bootrom call waits up to 100ms.
+typedef enum _SAFEROTP_LOCK_STATUS {
+    SAFEROTP_LOCK_STATUS_OK           = 0, // lock acquired (or: no bootrom call has timed out)
+    SAFEROTP_LOCK_STATUS_BUSY         = 1, // timed out: the other core (or another task) holds the lock, or BOOTLOCK2
+    SAFEROTP_LOCK_STATUS_ALREADY_HELD = 2, // the caller already holds the lock (it is not recursive)
+    SAFEROTP_LOCK_STATUS_NOT_HELD     = 3, // saferotp_lock_last_status(): the caller does not hold the lock
+} SAFEROTP_LOCK_STATUS;
+// Returns a SAFEROTP_LOCK_STATUS.
+uint8_t saferotp_lock_acquire(uint32_t timeout_us);
+// Returns false if the caller does not hold the lock.
+bool saferotp_lock_release(void);
+// Returns SAFEROTP_LOCK_STATUS_BUSY if any bootrom call made for the caller, since its
+// saferotp_lock_acquire(), gave up waiting for BOOTLOCK2; this distinguishes a busy
+// bootrom from other failures.  Otherwise returns SAFEROTP_LOCK_STATUS_OK, or
+// SAFEROTP_LOCK_STATUS_NOT_HELD if the caller does not hold the lock.
+uint8_t saferotp_lock_last_status(void);
 
 #pragma endregion // OTP Read / Write functions
 
@@ -0,0 +1,47 @@
+#pragma once
+
+#ifndef SAFEROTP_DIRENTRY_ITER_H
+#define SAFEROTP_DIRENTRY_ITER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "saferotp_direntry.h" // SAFEROTP_OTPDIR_ENTRY_TYPE
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#pragma region    // OTP Directory caller-owned iterators
+
+// Caller-owned position within the OTP directory.
+// The saferotp_otpdir_find_xxx() / saferotp_otpdir_get_current_xxx() functions
+// keep a single position per core, so two RTOS tasks on the same core, or a lookup
+// nested inside a loop over entries, would move each other's position.
+// Each SAFEROTP_OTPDIR_ITER holds its own position instead, so any number of
+// scans may be in progress at once.  The contents are opaque to callers.
+// A zero-initialized iterator is valid, but has no current entry until
+// saferotp_otpdir_iter_first() (or saferotp_otpdir_iter_first_of_type()) is called.
+typedef struct _SAFEROTP_OTPDIR_ITER {
+    uint16_t opaque[8];
+} SAFEROTP_OTPDIR_ITER;
+
+// Same as saferotp_otpdir_find_first_entry() / saferotp_otpdir_find_next_entry(),
+// using (and updating) only the given iterator.
+bool saferotp_otpdir_iter_first(SAFEROTP_OTPDIR_ITER* iter);
+bool saferotp_otpdir_iter_next(SAFEROTP_OTPDIR_ITER* iter);
+// Same as saferotp_otpdir_find_first_entry_of_type() / saferotp_otpdir_find_next_entry_of_type().
+bool saferotp_otpdir_iter_first_of_type(SAFEROTP_OTPDIR_ITER* iter, SAFEROTP_OTPDIR_ENTRY_TYPE entryType);
+bool saferotp_otpdir_iter_next_of_type(SAFEROTP_OTPDIR_ITER* iter, SAFEROTP_OTPDIR_ENTRY_TYPE entryType);
+// Same as the saferotp_otpdir_get_current_entry_xxx() functions, for the iterator's current entry.
+SAFEROTP_OTPDIR_ENTRY_TYPE saferotp_otpdir_iter_get_type(const SAFEROTP_OTPDIR_ITER* iter);
+size_t saferotp_otpdir_iter_get_buffer_size(const SAFEROTP_OTPDIR_ITER* iter);
+size_t saferotp_otpdir_iter_get_data(const SAFEROTP_OTPDIR_ITER* iter, void* buffer, size_t buffer_size);
+
+#pragma endregion // OTP Directory caller-owned iterators
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SAFEROTP_DIRENTRY_ITER_H
@@ -21,12 +21,23 @@ typedef enum _SAFEROTP_ECC_ERROR {
     SAFEROTP_ECC_ERROR_INVALID_INPUT                   = 0x7F010000u,
     SAFEROTP_ECC_ERROR_DETECTED_MULTI_BIT_ERROR        = 0x7F020000u,
     SAFEROTP_ECC_ERROR_BRBP_NEITHER_DECODING_VALID     = 0x7F030000u, // BRBP = 0b10 or 0b01, but neither decodes precisely
-    SAFEROTP_ECC_ERROR_NOT_VALID_SINGLE_BIT_FLIP       = 0x7F050000u, // 
-    SAFEROTP_ECC_ERROR_INVALID_ENCODING                = 0x7F040000u, // Syndrome alone generates data, but too many bit flips...
-    SAFEROTP_ECC_ERROR_BRBP_DUAL_DECODINGS_POSSIBLE    = 0x40000000u, // TODO: prove code makes this impossible to hit
-    SAFEROTP_ECC_ERROR_INTERNAL_ERROR_BRBP_BIT         = 0x40010000u, // TODO: prove code makes this impossible to hit
-    SAFEROTP_ECC_ERROR_INTERNAL_ERROR_PERFECT_MATCH    = 0x40020000u, // TODO: prove code makes this impossible to hit
-    SAFEROTP_ECC_ERROR_POTENTIALLY_READABLE_BY_BOOTROM = 0x7F990000u, // TODO: prove or disprove bootrom behavior for these cases (all have 3 or 5 flipped bits)
+    SAFEROTP_ECC_ERROR_NOT_VALID_SINGLE_BIT_FLIP       = 0x7F050000u, // odd bit flips, but syndrome does not point to a single bit
+    SAFEROTP_ECC_ERROR_INVALID_ENCODING                = 0x7F040000u, // Not returned by the current decoder (see below)
+    SAFEROTP_ECC_ERROR_BRBP_DUAL_DECODINGS_POSSIBLE    = 0x40000000u, // Not returned by the current decoder (see below)
+    SAFEROTP_ECC_ERROR_INTERNAL_ERROR_BRBP_BIT         = 0x40010000u, // even bit flips, syndrome 0x01: value matches only with the opposite polarity (see below)
+    SAFEROTP_ECC_ERROR_INTERNAL_ERROR_PERFECT_MATCH    = 0x40020000u, // Not returned by the current decoder (see below)
+    SAFEROTP_ECC_ERROR_POTENTIALLY_READABLE_BY_BOOTROM = 0x7F990000u, // Not returned by the current decoder (see below)
+    // All 2^24 raw values are decoded, and each result tallied, by tools/saferotp_ecc_verify.c
+    // (which fails if these counts change; see also docs/PURPOSE.md):
+    //     3,276,800  decode successfully (65,536 values x 2 polarities x (1 + 24 single-bit flips))
+    //     3,932,160  DETECTED_MULTI_BIT_ERROR
+    //     8,126,464  BRBP_NEITHER_DECODING_VALID
+    //     1,310,720  NOT_VALID_SINGLE_BIT_FLIP
+    //       131,072  INTERNAL_ERROR_BRBP_BIT ... reachable, e.g., by flipping hamming_ecc bit 0 and the parity bit.
+    //                Despite the name, this is just another detected two-bit error.
+    //             0  INVALID_ENCODING, BRBP_DUAL_DECODINGS_POSSIBLE, INTERNAL_ERROR_PERFECT_MATCH,
+    //                and POTENTIALLY_READABLE_BY_BOOTROM.  The values are kept so existing code
+    //                that compares against them continues to compile.
 } SAFEROTP_ECC_ERROR;
 
 // When reading ECC OTP data using RAW reads, the result is an opaque 32-bit value.
@@ -55,6 +66,42 @@ typedef struct _SAFER_OTP_RAW_READ_RESULT {
 } SAFEROTP_RAW_READ_RESULT;
 static_assert(sizeof(SAFEROTP_RAW_READ_RESULT) == sizeof(uint32_t));
 
+// Per-row health, as reported by saferotp_decode_raw_with_details().
+typedef enum _SAFEROTP_ECC_ROW_STATUS {
+    SAFEROTP_ECC_ROW_STATUS_CLEAN       = 0, // decoded with no bit flips
+    SAFEROTP_ECC_ROW_STATUS_CORRECTED   = 1, // decoded, after correcting / ignoring a single bit flip
+    SAFEROTP_ECC_ROW_STATUS_ERROR       = 2, // not decodable; see `result` for the SAFEROTP_ECC_ERROR
+    SAFEROTP_ECC_ROW_STATUS_READ_FAILED = 3, // the raw OTP row could not be read (only from OTP read functions)
+} SAFEROTP_ECC_ROW_STATUS;
+
+// Compact (8 byte) per-row descriptor of an ECC decoding.
+// Allows health monitoring (e.g., counting corrected rows) without a second decode.
+typedef struct _SAFEROTP_ECC_DECODE_DETAILS {
+    uint32_t result;        // identical to saferotp_decode_raw(): 16-bit value, or a SAFEROTP_ECC_ERROR
+    int8_t   flipped_bit;   // raw bit index (0..23) of the corrected / ignored bit flip, or -1 if none
+    uint8_t  status;        // SAFEROTP_ECC_ROW_STATUS
+    uint8_t  brbp_inverted; // 1 if the row was stored inverted (BRBP 0b11), else 0
+    uint8_t  reserved;      // always zero
+} SAFEROTP_ECC_DECODE_DETAILS;
+static_assert(sizeof(SAFEROTP_ECC_DECODE_DETAILS) == 2 * sizeof(uint32_t));
+
+// What to do for one OTP row, as planned by saferotp_plan_ecc_writes().
+typedef enum _SAFEROTP_ECC_WRITE_PLAN_ACTION {
+    SAFEROTP_ECC_WRITE_PLAN_NO_WRITE       = 0, // existing row already decodes to the value
+    SAFEROTP_ECC_WRITE_PLAN_WRITE          = 1, // write `raw_to_write`; row will have full ECC redundancy
+    SAFEROTP_ECC_WRITE_PLAN_WRITE_DEGRADED = 2, // write `raw_to_write`; row will decode, but with bit error(s) already present
+    SAFEROTP_ECC_WRITE_PLAN_IMPOSSIBLE     = 3, // existing bits prevent storing the value (or row was unreadable)
+} SAFEROTP_ECC_WRITE_PLAN_ACTION;
+
+typedef struct _SAFEROTP_ECC_WRITE_PLAN {
+    uint32_t raw_to_write; // raw value to program (existing bits are always included)
+    uint8_t  action;       // SAFEROTP_ECC_WRITE_PLAN_ACTION
+    uint8_t  new_bits;     // count of fuses that will be newly burned
+    uint8_t  inverted;     // 1 if using the BRBP-inverted encoding, else 0
+    uint8_t  reserved;     // always zero
+} SAFEROTP_ECC_WRITE_PLAN;
+static_assert(sizeof(SAFEROTP_ECC_WRITE_PLAN) == 2 * sizeof(uint32_t));
+
 // Given the 16-bit value to be stored using ECC encoding,
 // Get the 32-bit value (castable to SAFEROTP_RAW_READ_RESULT),
 // containing both the hamming_ecc and parity_bit fields.
@@ -68,6 +115,55 @@ uint32_t saferotp_calculate_ecc(uint16_t x); // [[unsequenced]]
 // as only 16 bit values can be stored using the ECC encoding.
 uint32_t saferotp_decode_raw(uint32_t data); // [[unsequenced]]
 
+// Same as saferotp_decode_raw(), but also fills in the details of the decoding
+// (clean vs. corrected, which bit was flipped, and BRBP polarity) in the same pass.
+uint32_t saferotp_decode_raw_with_details(uint32_t data, SAFEROTP_ECC_DECODE_DETAILS* out_details);
+// Batch version of saferotp_decode_raw_with_details(), for `count` raw values.
+void saferotp_decode_raw_batch_with_details(const uint32_t* raw, SAFEROTP_ECC_DECODE_DETAILS* out_details, size_t count);
+
+// Plans ECC writes for `count` rows, before anything is programmed.
+// Given the existing raw row values (0xFFFFFFFFu for unreadable rows) and
+// the desired 16-bit values, chooses for each row the normal or BRBP-inverted
+// encoding that still decodes correctly once OR'd with the existing bits,
+// preferring encodings without bit errors, then the fewest newly burned bits.
+// Returns the number of rows that cannot be written (SAFEROTP_ECC_WRITE_PLAN_IMPOSSIBLE).
+size_t saferotp_plan_ecc_writes(const uint32_t* existing_raw, const uint16_t* values, SAFEROTP_ECC_WRITE_PLAN* out_plan, size_t count);
+
+// Batch version of saferotp_calculate_ecc().
+// For each of the `count` values, stores the encoded 32-bit value in `out`.
+// Results are identical to calling saferotp_calculate_ecc() for each value.
+void saferotp_calculate_ecc_batch(const uint16_t* values, uint32_t* out, size_t count);
+
+// Batch version of saferotp_decode_raw().
+// For each of the `count` raw values, stores the decoded result in `out`
+// (including the error codes in the top 8 bits).  `out` may be the same
+// buffer as `raw`.  Results are identical to calling saferotp_decode_raw()
+// for each value.  On x86-64 hosts, uses SSE4.1 / AVX2 when available.
+void saferotp_decode_raw_batch(const uint32_t* raw, uint32_t* out, size_t count);
+
+// For testing: the two batch functions above, using one particular kernel rather
+// than the one dispatched to, so that every kernel can be checked on one host.
+// Returns false (and does nothing) if the kernel is not in this build, or is not
+// supported by this CPU.
+typedef enum _SAFEROTP_ECC_BATCH_KERNEL {
+    SAFEROTP_ECC_BATCH_KERNEL_PORTABLE = 0, // table-driven loop (all platforms)
+    SAFEROTP_ECC_BATCH_KERNEL_SSE41    = 1, // x86-64 only
+    SAFEROTP_ECC_BATCH_KERNEL_AVX2     = 2, // x86-64 only
+    SAFEROTP_ECC_BATCH_KERNEL_COUNT,
+} SAFEROTP_ECC_BATCH_KERNEL;
+bool saferotp_calculate_ecc_batch_kernel(uint8_t kernel, const uint16_t* values, uint32_t* out, size_t count);
+bool saferotp_decode_raw_batch_kernel(uint8_t kernel, const uint32_t* raw, uint32_t* out, size_t count);
+
+// Bit-sliced versions of saferotp_calculate_ecc() and saferotp_decode_raw().
+// These process 32 rows (or a full 64-row OTP page) at a time, using only
+// 32-bit logic operations, without data-dependent branches or table lookups.
+// Results for each row are identical to the single-value functions.
+// `out` may be the same buffer as the input for the decode functions.
+void saferotp_calculate_ecc_x32(const uint16_t values[32], uint32_t out[32]);
+void saferotp_decode_raw_x32(const uint32_t raw[32], uint32_t out[32]);
+void saferotp_calculate_ecc_page(const uint16_t values[64], uint32_t out[64]);
+void saferotp_decode_raw_page(const uint32_t raw[64], uint32_t out[64]);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,94 @@
+#pragma once
+
+#ifndef SAFEROTP_ECC_HPP
+#define SAFEROTP_ECC_HPP
+
+// Header-only, C++17 `constexpr` version of the ECC encoder.
+//
+// Allows firmware to generate entire ECC-encoded OTP row images at compile time,
+// so provisioning code can write the precomputed raw rows (for example, with
+// saferotp_write_data_raw_unsafe()) without any runtime encoding.
+//
+//     constexpr std::array<uint16_t, 3> values = { 0x1234u, 0xA5A5u, 0xFFFFu };
+//     constexpr auto rows = saferotp::ecc_encode_rows(values);
+//     static_assert(rows[0] == 0x191234u);
+//
+// Results are identical to saferotp_calculate_ecc() in saferotp_ecc.c.
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace saferotp {
+
+// Each of the five hamming_ecc bits covers these data bits.
+// (Same as the parity table in saferotp_ecc.c)
+inline constexpr uint32_t ecc_data_masks[5] = {
+    0x00AD5Bu,
+    0x00366Du,
+    0x00C78Eu,
+    0x0007F0u,
+    0x00F800u,
+};
+inline constexpr uint32_t ecc_brbp_bits    = 0xC00000u;
+inline constexpr uint32_t ecc_all_raw_bits = 0xFFFFFFu;
+
+constexpr uint32_t ecc_even_parity(uint32_t x) {
+    uint32_t rc = 0u;
+    for (; x != 0u; x >>= 1) {
+        rc ^= x & 1u;
+    }
+    return rc;
+}
+
+// Same as saferotp_calculate_ecc(): the raw row for `x`, with BRBP bits zero.
+constexpr uint32_t ecc_calculate(uint16_t x) {
+    uint32_t result = x;
+    for (uint32_t i = 0u; i < 5u; ++i) {
+        result |= ecc_even_parity(x & ecc_data_masks[i]) << (16u + i);
+    }
+    // parity bit covers the data and the hamming_ecc bits
+    result |= ecc_even_parity(result) << 21u;
+    return result;
+}
+
+// The raw row for `x`, stored inverted (both BRBP bits set).
+// This is the encoding used when the normal encoding cannot be written
+// because bits that must be zero are already set in the OTP row.
+constexpr uint32_t ecc_calculate_brbp(uint16_t x) {
+    return ecc_calculate(x) ^ ecc_all_raw_bits;
+}
+
+// Encodes an entire image of 16-bit values into raw OTP rows.
+template <std::size_t N>
+constexpr std::array<uint32_t, N> ecc_encode_rows(const std::array<uint16_t, N>& values) {
+    std::array<uint32_t, N> rows{};
+    for (std::size_t i = 0u; i < N; ++i) {
+        rows[i] = ecc_calculate(values[i]);
+    }
+    return rows;
+}
+
+// Same as ecc_encode_rows(), but each row is stored inverted (BRBP).
+template <std::size_t N>
+constexpr std::array<uint32_t, N> ecc_encode_rows_brbp(const std::array<uint16_t, N>& values) {
+    std::array<uint32_t, N> rows{};
+    for (std::size_t i = 0u; i < N; ++i) {
+        rows[i] = ecc_calculate_brbp(values[i]);
+    }
+    return rows;
+}
+
+// Known values, as computed by saferotp_calculate_ecc()
+static_assert(ecc_calculate(0x0000u) == 0x000000u);
+static_assert(ecc_calculate(0x0001u) == 0x230001u);
+static_assert(ecc_calculate(0x8000u) == 0x158000u);
+static_assert(ecc_calculate(0x1234u) == 0x191234u);
+static_assert(ecc_calculate(0xA5A5u) == 0x27A5A5u);
+static_assert(ecc_calculate(0xFFFFu) == 0x1EFFFFu);
+static_assert(ecc_calculate_brbp(0x0000u) == 0xFFFFFFu);
+static_assert((ecc_calculate_brbp(0x1234u) & ecc_brbp_bits) == ecc_brbp_bits);
+
+} // namespace saferotp
+
+#endif // defined SAFEROTP_ECC_HPP
@@ -9,6 +9,7 @@
 #include "pico/stdlib.h" // required for get_core_num()
 #include "saferotp.h"
 #include "saferotp_direntry.h"
+#include "saferotp_direntry_iter.h"
 #include "saferotp_debug_stub.h"
 
 static volatile bool g_WaitForKey_otpdir = false;
@@ -123,9 +124,23 @@ typedef struct _X_ITERATOR_STATE {
 
 // One "current" OTP_DIRENTRY location is stored for each core.
 // This avoids the need for cores to synchronize their read-only operations
-// on the OTP directory.
+// on the OTP directory.  Callers that need more than one position at a time
+// (e.g., RTOS tasks, or nested lookups) use their own SAFEROTP_OTPDIR_ITER instead.
+// The caller-owned iterator is opaque storage for an X_ITERATOR_STATE, which is
+// copied in and out with memcpy() (never accessed through a cast pointer).
+static_assert(sizeof(X_ITERATOR_STATE) <= sizeof(SAFEROTP_OTPDIR_ITER), "SAFEROTP_OTPDIR_ITER too small");
 static X_ITERATOR_STATE x_current_directory_entry[xCORE_COUNT] = {};
 
+static X_ITERATOR_STATE* x_current_core_iterator(void) {
+    return &x_current_directory_entry[ get_core_num() ];
+}
+static void x_iterator_load(X_ITERATOR_STATE* state, const SAFEROTP_OTPDIR_ITER* iter) {
+    memcpy(state, iter, sizeof(X_ITERATOR_STATE));
+}
+static void x_iterator_store(SAFEROTP_OTPDIR_ITER* iter, const X_ITERATOR_STATE* state) {
+    memcpy(iter, state, sizeof(X_ITERATOR_STATE));
+}
+
 #pragma region    // Basic CRC16
 // It is critical that this CRC return a value of 0x0000u
 // when the data provided to it is all-zero, to account for
@@ -425,14 +440,12 @@ static bool x_otp_direntry_find_next_entry(X_ITERATOR_STATE* state, uint16_t sta
     }
 }
 // Ref: FindFirstFile()
-static bool x_otp_direntry_reset_directory_iterator(void) {
-    X_ITERATOR_STATE* state = &x_current_directory_entry[ get_core_num() ];
+static bool x_otp_direntry_reset_directory_iterator(X_ITERATOR_STATE* state) {
     uint16_t starting_row = xSTART_ROW;
     return x_otp_direntry_find_next_entry(state, starting_row);
 }
 // Ref: FindNextFile()
-static bool x_otp_direntry_move_to_next_entry(void) {
-    X_ITERATOR_STATE* state = &x_current_directory_entry[ get_core_num() ];
+static bool x_otp_direntry_move_to_next_entry(X_ITERATOR_STATE* state) {
     if (!state->entry_validated) {
         return false; // do nothing ...
     }
@@ -448,17 +461,15 @@ static bool x_otp_direntry_move_to_next_entry(void) {
 // 1. Get the current type
 // 2. Get size of buffer required to read the corresponding data
 // 3. Read the corresponding data into a caller-supplied buffer
-static SAFEROTP_OTPDIR_ENTRY_TYPE x_otp_direntry_get_current_type(void) {
-    X_ITERATOR_STATE* state = &x_current_directory_entry[ get_core_num() ];
+static SAFEROTP_OTPDIR_ENTRY_TYPE x_otp_direntry_get_current_type(const X_ITERATOR_STATE* state) {
     if (!state->entry_validated) {
         return SAFEROTP_OTPDIR_ENTRY_TYPE_END;
     }
     return state->current_entry.entry_type;
 }
 
-static size_t x_otp_direntry_get_current_buffer_size_required(void) {
+static size_t x_otp_direntry_get_current_buffer_size_required(const X_ITERATOR_STATE* state) {
 
-    X_ITERATOR_STATE* state = &x_current_directory_entry[ get_core_num() ];
     size_t result = 0u;
 
     if (!state->entry_validated) {
@@ -491,15 +502,14 @@ static size_t x_otp_direntry_get_current_buffer_size_required(void) {
     return result;
 }
 
-static size_t x_otp_direntry_get_current_entry_data(void* buffer, size_t buffer_size) {
-    X_ITERATOR_STATE* state = &x_current_directory_entry[ get_core_num() ];
+static size_t x_otp_direntry_get_current_entry_data(const X_ITERATOR_STATE* state, void* buffer, size_t buffer_size) {
 
     if (buffer_size == 0u) {
         PRINT_ERROR("Requested zero bytes of data for the current OTPDIR entry ... this is an error in the calling code");
         return 0u;
     }
     memset(buffer, 0, buffer_size);
-    size_t required_size = x_otp_direntry_get_current_buffer_size_required();
+    size_t required_size = x_otp_direntry_get_current_buffer_size_required(state);
     if (required_size == 0u) {
         PRINT_WARNING(
             "Current directory entry has zero bytes of data ... caller should not attempt to read data\n"
@@ -528,34 +538,22 @@ static size_t x_otp_direntry_get_current_entry_data(void* buffer, size_t buffer_
         }
         case SAFEROTP_OTPDIR_DATA_ENCODING_TYPE_BYTE3X: {
             uint16_t start_row = state->current_entry.byte3x_data.start_row;
-            size_t number_of_reads_required = required_size;
-            uint8_t* p = buffer; // for pointer arithmetic
-            for (size_t i = 0; i < number_of_reads_required; ++i) {
-                if (!saferotp_read_single_value_byte3x(start_row+i, p+i)) {
-                    return 0u;
-                }
+            if (!saferotp_read_data_byte3x(start_row, buffer, required_size)) {
+                return 0u;
             }
             return required_size;
         }
         case SAFEROTP_OTPDIR_DATA_ENCODING_TYPE_RBIT3: {
             uint16_t start_row = state->current_entry.rbit3_data.start_row;
-            size_t number_of_reads_required = required_size / sizeof(uint32_t);
-            uint32_t* p = (uint32_t*)buffer; // for pointer arithmetic
-            for (size_t i = 0; i < number_of_reads_required; ++i) {
-                if (!saferotp_read_single_value_rbit3(start_row+(i*3), p+i)) {
-                    return 0u;
-                }
+            if (!saferotp_read_data_rbit3(start_row, buffer, required_size)) {
+                return 0u;
             }
             return required_size;
         }
         case SAFEROTP_OTPDIR_DATA_ENCODING_TYPE_RBIT8: {
             uint16_t start_row = state->current_entry.rbit8_data.start_row;
-            size_t number_of_reads_required = required_size / sizeof(uint32_t);
-            uint32_t* p = (uint32_t*)buffer; // for pointer arithmetic
-            for (size_t i = 0; i < number_of_reads_required; ++i) {
-                if (!saferotp_read_single_value_rbit8(start_row+(i*8), p+i)) {
-                    return 0u;
-                }
+            if (!saferotp_read_data_rbit8(start_row, buffer, required_size)) {
+                return 0u;
             }
             return required_size;
         }
@@ -594,37 +592,45 @@ static size_t x_otp_direntry_get_current_entry_data(void* buffer, size_t buffer_
     return 0u;
 }
 
+// Advances until the current entry is of the given type (the current entry may already match)
+static bool x_otp_direntry_skip_to_type(X_ITERATOR_STATE* state, SAFEROTP_OTPDIR_ENTRY_TYPE entryType) {
+    while (x_otp_direntry_get_current_type(state).as_uint16 != entryType.as_uint16) {
+        if (!x_otp_direntry_move_to_next_entry(state)) {
+            return false;
+        }
+    }
+    return true;
+}
+static bool x_otp_direntry_first_of_type(X_ITERATOR_STATE* state, SAFEROTP_OTPDIR_ENTRY_TYPE entryType) {
+    if (!x_otp_direntry_reset_directory_iterator(state)) {
+        return false;
+    }
+    return x_otp_direntry_skip_to_type(state, entryType);
+}
+static bool x_otp_direntry_next_of_type(X_ITERATOR_STATE* state, SAFEROTP_OTPDIR_ENTRY_TYPE entryType) {
+    if (!x_otp_direntry_move_to_next_entry(state)) {
+        return false;
+    }
+    return x_otp_direntry_skip_to_type(state, entryType);
+}
+
 
 /// All code above this point are the static helper functions / implementation details.
 /// Only the below are the public API functions.
 
+// The following use the per-core "current" iterator, so only one position
+// can be held per core.  See the saferotp_otpdir_iter_xxx() functions below.
 bool saferotp_otpdir_find_first_entry(void) {
-    return x_otp_direntry_reset_directory_iterator();
+    return x_otp_direntry_reset_directory_iterator(x_current_core_iterator());
 }
 bool saferotp_otpdir_find_next_entry(void) {
-    return x_otp_direntry_move_to_next_entry();
+    return x_otp_direntry_move_to_next_entry(x_current_core_iterator());
 }
 bool saferotp_otpdir_find_first_entry_of_type(SAFEROTP_OTPDIR_ENTRY_TYPE entryType) {
-    if (!saferotp_otpdir_find_first_entry()) {
-        return false;
-    }
-    while (saferotp_otpdir_get_current_entry_type().as_uint16 != entryType.as_uint16) {
-        if (!saferotp_otpdir_find_next_entry()) {
-            return false;
-        }
-    }
-    return true;
+    return x_otp_direntry_first_of_type(x_current_core_iterator(), entryType);
 }
 bool saferotp_otpdir_find_next_entry_of_type(SAFEROTP_OTPDIR_ENTRY_TYPE entryType) {
-    if (!saferotp_otpdir_find_next_entry()) {
-        return false;
-    }
-    while (saferotp_otpdir_get_current_entry_type().as_uint16 != entryType.as_uint16) {
-        if (!saferotp_otpdir_find_next_entry()) {
-            return false;
-        }
-    }
-    return true;
+    return x_otp_direntry_next_of_type(x_current_core_iterator(), entryType);
 }
 
 // Reads the data from OTP on behalf of the caller.  If the data is successfully read (and validated,
@@ -634,18 +640,63 @@ bool saferotp_otpdir_find_next_entry_of_type(SAFEROTP_OTPDIR_ENTRY_TYPE entryTyp
 // On failure, returns zero.
 // The buffer provided must be at least saferotp_otpdir_get_current_entry_buffer_size() bytes in size.
 size_t saferotp_otpdir_get_current_entry_data(void* buffer, size_t buffer_size) {
-    return x_otp_direntry_get_current_entry_data(buffer, buffer_size);
+    return x_otp_direntry_get_current_entry_data(x_current_core_iterator(), buffer, buffer_size);
 }
 
 SAFEROTP_OTPDIR_ENTRY_TYPE saferotp_otpdir_get_current_entry_type(void) {
-    return x_otp_direntry_get_current_type();
+    return x_otp_direntry_get_current_type(x_current_core_iterator());
 }
 // Returns the buffer size (in bytes) required to get the data referenced by the current entry.
 // Gives a consistent API for all the various data encoding schemes (RAW, byte3x, RBIT3, RBIT8, etc.).
 // NOTE: By abstracting away the various encoding schemes, callers can simply allocate a buffer
 //       of the returned size, and simply deal with byte-based buffers, simplifying use of the API.
 size_t saferotp_otpdir_get_current_entry_buffer_size(void) {
-    return x_otp_direntry_get_current_buffer_size_required();
+    return x_otp_direntry_get_current_buffer_size_required(x_current_core_iterator());
+}
+
+// Caller-owned iterators: each SAFEROTP_OTPDIR_ITER holds its own position,
+// so any number of scans (on any core, nested, or from multiple RTOS tasks)
+// can be in progress at once, without restarting each other.
+bool saferotp_otpdir_iter_first(SAFEROTP_OTPDIR_ITER* iter) {
+    X_ITERATOR_STATE state;
+    bool result = x_otp_direntry_reset_directory_iterator(&state);
+    x_iterator_store(iter, &state);
+    return result;
+}
+bool saferotp_otpdir_iter_next(SAFEROTP_OTPDIR_ITER* iter) {
+    X_ITERATOR_STATE state;
+    x_iterator_load(&state, iter);
+    bool result = x_otp_direntry_move_to_next_entry(&state);
+    x_iterator_store(iter, &state);
+    return result;
+}
+bool saferotp_otpdir_iter_first_of_type(SAFEROTP_OTPDIR_ITER* iter, SAFEROTP_OTPDIR_ENTRY_TYPE entryType) {
+    X_ITERATOR_STATE state;
+    bool result = x_otp_direntry_first_of_type(&state, entryType);
+    x_iterator_store(iter, &state);
+    return result;
+}
+bool saferotp_otpdir_iter_next_of_type(SAFEROTP_OTPDIR_ITER* iter, SAFEROTP_OTPDIR_ENTRY_TYPE entryType) {
+    X_ITERATOR_STATE state;
+    x_iterator_load(&state, iter);
+    bool result = x_otp_direntry_next_of_type(&state, entryType);
+    x_iterator_store(iter, &state);
+    return result;
+}
+SAFEROTP_OTPDIR_ENTRY_TYPE saferotp_otpdir_iter_get_type(const SAFEROTP_OTPDIR_ITER* iter) {
+    X_ITERATOR_STATE state;
+    x_iterator_load(&state, iter);
+    return x_otp_direntry_get_current_type(&state);
+}
+size_t saferotp_otpdir_iter_get_buffer_size(const SAFEROTP_OTPDIR_ITER* iter) {
+    X_ITERATOR_STATE state;
+    x_iterator_load(&state, iter);
+    return x_otp_direntry_get_current_buffer_size_required(&state);
+}
+size_t saferotp_otpdir_iter_get_data(const SAFEROTP_OTPDIR_ITER* iter, void* buffer, size_t buffer_size) {
+    X_ITERATOR_STATE state;
+    x_iterator_load(&state, iter);
+    return x_otp_direntry_get_current_entry_data(&state, buffer, buffer_size);
 }
 
 bool saferotp_otpdir_add_entry_for_existing_ecc_data(
@@ -1,5 +1,18 @@
 #include "saferotp_ecc.h"
 
+// Selects how saferotp_calculate_ecc() generates the six ECC bits.
+// All variants produce identical results, trading flash / RAM for speed.
+// Approximate cost per encode (x86-64 host, -O2, all 2^16 values), as reported by
+// `saferotp_ecc_verify_loop --bench` and `saferotp_ecc_verify --bench` (see tools/):
+//     LOOP    : ~50 ns  (no tables; smallest flash)
+//     TABLE8  : ~1.3 ns (two 256-byte tables in flash)
+// A full 64k-entry table was also measured, but was no faster than TABLE8.
+#define SAFEROTP_ECC_ENCODER_LOOP    1
+#define SAFEROTP_ECC_ENCODER_TABLE8  2
+#ifndef SAFEROTP_ECC_ENCODER
+    #define SAFEROTP_ECC_ENCODER SAFEROTP_ECC_ENCODER_TABLE8
+#endif
+
 
 static const uint32_t SUCCESS_MASK = 0x0000FFFFu;
 
@@ -31,6 +44,7 @@ static const uint16_t sdk_otp_syndrome_to_bitflip[32] = {
     0x0000u, 0x0000u, 0x0000u, 0x0000u,  // [24..27]
     0x0000u, 0x0000u, 0x0000u, 0x0000u,  // [28..31]
 };
+#if SAFEROTP_ECC_ENCODER == SAFEROTP_ECC_ENCODER_LOOP
 static const uint32_t _otp_ecc_parity_table[6] = {
     0x00AD5Bu, // 0b00'0000'1010'1101'0101'1011,
     0x00366Du, // 0b00'0000'0011'0110'0110'1101,
@@ -47,7 +61,80 @@ static uint32_t _even_parity(uint32_t input) {
     }
     return rc;
 }
-static uint32_t decode_raw_data_with_correction_impl(const SAFEROTP_RAW_READ_RESULT data) {
+#elif SAFEROTP_ECC_ENCODER == SAFEROTP_ECC_ENCODER_TABLE8
+// The ECC encoding is linear, so the six ECC bits (bits 16..21) for a
+// 16-bit value are the XOR of the ECC bits for its low and high bytes.
+// _otp_ecc_bits_lo[i] == (saferotp_calculate_ecc(i)      >> 16)
+// _otp_ecc_bits_hi[i] == (saferotp_calculate_ecc(i << 8) >> 16)
+static const uint8_t _otp_ecc_bits_lo[256] = {
+    0x00u, 0x23u, 0x25u, 0x06u, 0x26u, 0x05u, 0x03u, 0x20u, 0x07u, 0x24u, 0x22u, 0x01u, 0x21u, 0x02u, 0x04u, 0x27u,
+    0x29u, 0x0Au, 0x0Cu, 0x2Fu, 0x0Fu, 0x2Cu, 0x2Au, 0x09u, 0x2Eu, 0x0Du, 0x0Bu, 0x28u, 0x08u, 0x2Bu, 0x2Du, 0x0Eu,
+    0x2Au, 0x09u, 0x0Fu, 0x2Cu, 0x0Cu, 0x2Fu, 0x29u, 0x0Au, 0x2Du, 0x0Eu, 0x08u, 0x2Bu, 0x0Bu, 0x28u, 0x2Eu, 0x0Du,
+    0x03u, 0x20u, 0x26u, 0x05u, 0x25u, 0x06u, 0x00u, 0x23u, 0x04u, 0x27u, 0x21u, 0x02u, 0x22u, 0x01u, 0x07u, 0x24u,
+    0x0Bu, 0x28u, 0x2Eu, 0x0Du, 0x2Du, 0x0Eu, 0x08u, 0x2Bu, 0x0Cu, 0x2Fu, 0x29u, 0x0Au, 0x2Au, 0x09u, 0x0Fu, 0x2Cu,
+    0x22u, 0x01u, 0x07u, 0x24u, 0x04u, 0x27u, 0x21u, 0x02u, 0x25u, 0x06u, 0x00u, 0x23u, 0x03u, 0x20u, 0x26u, 0x05u,
+    0x21u, 0x02u, 0x04u, 0x27u, 0x07u, 0x24u, 0x22u, 0x01u, 0x26u, 0x05u, 0x03u, 0x20u, 0x00u, 0x23u, 0x25u, 0x06u,
+    0x08u, 0x2Bu, 0x2Du, 0x0Eu, 0x2Eu, 0x0Du, 0x0Bu, 0x28u, 0x0Fu, 0x2Cu, 0x2Au, 0x09u, 0x29u, 0x0Au, 0x0Cu, 0x2Fu,
+    0x2Cu, 0x0Fu, 0x09u, 0x2Au, 0x0Au, 0x29u, 0x2Fu, 0x0Cu, 0x2Bu, 0x08u, 0x0Eu, 0x2Du, 0x0Du, 0x2Eu, 0x28u, 0x0Bu,
+    0x05u, 0x26u, 0x20u, 0x03u, 0x23u, 0x00u, 0x06u, 0x25u, 0x02u, 0x21u, 0x27u, 0x04u, 0x24u, 0x07u, 0x01u, 0x22u,
+    0x06u, 0x25u, 0x23u, 0x00u, 0x20u, 0x03u, 0x05u, 0x26u, 0x01u, 0x22u, 0x24u, 0x07u, 0x27u, 0x04u, 0x02u, 0x21u,
+    0x2Fu, 0x0Cu, 0x0Au, 0x29u, 0x09u, 0x2Au, 0x2Cu, 0x0Fu, 0x28u, 0x0Bu, 0x0Du, 0x2Eu, 0x0Eu, 0x2Du, 0x2Bu, 0x08u,
+    0x27u, 0x04u, 0x02u, 0x21u, 0x01u, 0x22u, 0x24u, 0x07u, 0x20u, 0x03u, 0x05u, 0x26u, 0x06u, 0x25u, 0x23u, 0x00u,
+    0x0Eu, 0x2Du, 0x2Bu, 0x08u, 0x28u, 0x0Bu, 0x0Du, 0x2Eu, 0x09u, 0x2Au, 0x2Cu, 0x0Fu, 0x2Fu, 0x0Cu, 0x0Au, 0x29u,
+    0x0Du, 0x2Eu, 0x28u, 0x0Bu, 0x2Bu, 0x08u, 0x0Eu, 0x2Du, 0x0Au, 0x29u, 0x2Fu, 0x0Cu, 0x2Cu, 0x0Fu, 0x09u, 0x2Au,
+    0x24u, 0x07u, 0x01u, 0x22u, 0x02u, 0x21u, 0x27u, 0x04u, 0x23u, 0x00u, 0x06u, 0x25u, 0x05u, 0x26u, 0x20u, 0x03u,
+};
+static const uint8_t _otp_ecc_bits_hi[256] = {
+    0x00u, 0x0Du, 0x0Eu, 0x03u, 0x2Fu, 0x22u, 0x21u, 0x2Cu, 0x31u, 0x3Cu, 0x3Fu, 0x32u, 0x1Eu, 0x13u, 0x10u, 0x1Du,
+    0x32u, 0x3Fu, 0x3Cu, 0x31u, 0x1Du, 0x10u, 0x13u, 0x1Eu, 0x03u, 0x0Eu, 0x0Du, 0x00u, 0x2Cu, 0x21u, 0x22u, 0x2Fu,
+    0x13u, 0x1Eu, 0x1Du, 0x10u, 0x3Cu, 0x31u, 0x32u, 0x3Fu, 0x22u, 0x2Fu, 0x2Cu, 0x21u, 0x0Du, 0x00u, 0x03u, 0x0Eu,
+    0x21u, 0x2Cu, 0x2Fu, 0x22u, 0x0Eu, 0x03u, 0x00u, 0x0Du, 0x10u, 0x1Du, 0x1Eu, 0x13u, 0x3Fu, 0x32u, 0x31u, 0x3Cu,
+    0x34u, 0x39u, 0x3Au, 0x37u, 0x1Bu, 0x16u, 0x15u, 0x18u, 0x05u, 0x08u, 0x0Bu, 0x06u, 0x2Au, 0x27u, 0x24u, 0x29u,
+    0x06u, 0x0Bu, 0x08u, 0x05u, 0x29u, 0x24u, 0x27u, 0x2Au, 0x37u, 0x3Au, 0x39u, 0x34u, 0x18u, 0x15u, 0x16u, 0x1Bu,
+    0x27u, 0x2Au, 0x29u, 0x24u, 0x08u, 0x05u, 0x06u, 0x0Bu, 0x16u, 0x1Bu, 0x18u, 0x15u, 0x39u, 0x34u, 0x37u, 0x3Au,
+    0x15u, 0x18u, 0x1Bu, 0x16u, 0x3Au, 0x37u, 0x34u, 0x39u, 0x24u, 0x29u, 0x2Au, 0x27u, 0x0Bu, 0x06u, 0x05u, 0x08u,
+    0x15u, 0x18u, 0x1Bu, 0x16u, 0x3Au, 0x37u, 0x34u, 0x39u, 0x24u, 0x29u, 0x2Au, 0x27u, 0x0Bu, 0x06u, 0x05u, 0x08u,
+    0x27u, 0x2Au, 0x29u, 0x24u, 0x08u, 0x05u, 0x06u, 0x0Bu, 0x16u, 0x1Bu, 0x18u, 0x15u, 0x39u, 0x34u, 0x37u, 0x3Au,
+    0x06u, 0x0Bu, 0x08u, 0x05u, 0x29u, 0x24u, 0x27u, 0x2Au, 0x37u, 0x3Au, 0x39u, 0x34u, 0x18u, 0x15u, 0x16u, 0x1Bu,
+    0x34u, 0x39u, 0x3Au, 0x37u, 0x1Bu, 0x16u, 0x15u, 0x18u, 0x05u, 0x08u, 0x0Bu, 0x06u, 0x2Au, 0x27u, 0x24u, 0x29u,
+    0x21u, 0x2Cu, 0x2Fu, 0x22u, 0x0Eu, 0x03u, 0x00u, 0x0Du, 0x10u, 0x1Du, 0x1Eu, 0x13u, 0x3Fu, 0x32u, 0x31u, 0x3Cu,
+    0x13u, 0x1Eu, 0x1Du, 0x10u, 0x3Cu, 0x31u, 0x32u, 0x3Fu, 0x22u, 0x2Fu, 0x2Cu, 0x21u, 0x0Du, 0x00u, 0x03u, 0x0Eu,
+    0x32u, 0x3Fu, 0x3Cu, 0x31u, 0x1Du, 0x10u, 0x13u, 0x1Eu, 0x03u, 0x0Eu, 0x0Du, 0x00u, 0x2Cu, 0x21u, 0x22u, 0x2Fu,
+    0x00u, 0x0Du, 0x0Eu, 0x03u, 0x2Fu, 0x22u, 0x21u, 0x2Cu, 0x31u, 0x3Cu, 0x3Fu, 0x32u, 0x1Eu, 0x13u, 0x10u, 0x1Du,
+};
+#endif
+// Each of the five hamming_ecc bits covers the data bits from the
+// corresponding `_otp_ecc_parity_table` entry, plus the ECC bit itself.
+// For a validly encoded row, the parity of (raw & mask) is zero for each of these.
+// Similarly, the parity bit makes the low 22 bits (data + ECC + parity) have even parity.
+// Thus, the parity of each of these six masks directly gives the syndrome.
+static const uint32_t _otp_ecc_syndrome_masks[5] = {
+    0x01AD5Bu, // _otp_ecc_parity_table[0] | (1u << 16)
+    0x02366Du, // _otp_ecc_parity_table[1] | (1u << 17)
+    0x04C78Eu, // _otp_ecc_parity_table[2] | (1u << 18)
+    0x0807F0u, // _otp_ecc_parity_table[3] | (1u << 19)
+    0x10F800u, // _otp_ecc_parity_table[4] | (1u << 20)
+};
+static const uint32_t _otp_ecc_overall_parity_mask = 0x3FFFFFu;
+
+// Inverting all 22 non-BRBP bits of a row only changes the syndrome
+// by this value.  Each mask above covers an even number of bits, except
+// for the first one ... and the overall parity covers 22 bits (even).
+// This is also why a syndrome of 0b00001 with even overall parity is
+// exactly the BRBP-inverted encoding of some valid value.
+static const uint32_t SYNDROME_OF_INVERTED_ROW = 0x01u;
+
+static inline uint32_t _syndrome(uint32_t raw) {
+    uint32_t syndrome = 0u;
+    for (uint_fast8_t i = 0; i < 5u; ++i) {
+        syndrome |= ((uint32_t)__builtin_parity(raw & _otp_ecc_syndrome_masks[i])) << i;
+    }
+    return syndrome;
+}
+
+// Also reports the raw bit index (0..23) of any single bit flip that was
+// tolerated / corrected (else -1), and whether the row was stored inverted (BRBP).
+static uint32_t decode_raw_data_with_correction_impl(const SAFEROTP_RAW_READ_RESULT data, int8_t* flipped_bit, bool* inverted) {
     // If this decodes correctly, only the lower 16-bits will be set.
     // Else, at least the top eight bits will be set, to indicate
     // an error condition.  (FFxxxxxx)
@@ -56,33 +143,40 @@ static uint32_t decode_raw_data_with_correction_impl(const SAFEROTP_RAW_READ_RES
     // the ECC memory-mapped alias does, as described in datasheet:
     // See section 13.6.1 Bit Repair By Polarity @ page 1264
     // See section 13.6.2 Modified Hamming ECC @ page 1265
+    //
+    // Rather than re-calculating the ECC bits for the (possibly inverted)
+    // data and comparing against the stored bits, this calculates the
+    // syndrome directly from the raw 24-bit value.  Because the code is
+    // linear, inverting the row (BRBP) only XORs a constant into the
+    // syndrome, so both polarities are handled from a single calculation.
+
+    *flipped_bit = -1;
+    *inverted = false;
 
     // Input must be limited to 24-bit values
     if (data.as_uint32 & 0xFF000000u) {
         return SAFEROTP_ECC_ERROR_INVALID_INPUT;
     }
-    // 0. if only one BRBP bit is set, then check if exact match...
+
+    uint32_t syndrome      = _syndrome(data.as_uint32);
+    uint32_t parity_odd    = __builtin_parity(data.as_uint32 & _otp_ecc_overall_parity_mask);
+
+    // 0. if only one BRBP bit is set, then it must be an exact match...
+    //    either as stored (true BRBP was 0b00), or inverted (true BRBP was 0b11).
+    //    Both cannot be true, because the all-ones 22-bit value is not a valid encoding.
     if ((data.bit_repair_by_polarity == 0x1u) || (data.bit_repair_by_polarity == 0x2u)) {
-        const uint16_t decoded_wo_brbp =  data.as_uint32;
-        const uint16_t decoded_w__brbp = ~data.as_uint32;
-        const SAFEROTP_RAW_READ_RESULT src_wo_brbp = { .as_uint32 = saferotp_calculate_ecc( decoded_wo_brbp )              };
-        const SAFEROTP_RAW_READ_RESULT src_w__brbp = { .as_uint32 = saferotp_calculate_ecc( decoded_w__brbp ) ^ 0x00FFFFFF };
-
-        uint32_t diff_wo_brbp = data.as_uint32 ^ src_wo_brbp.as_uint32;
-        uint32_t diff_w__brbp = data.as_uint32 ^ src_w__brbp.as_uint32;
-        bool match_wo_brbp = (diff_wo_brbp == 0x00800000u) || (diff_wo_brbp == 0x00400000u);
-        bool match_w__brbp = (diff_w__brbp == 0x00800000u) || (diff_w__brbp == 0x00400000u);
-
-        // Are both of those decodings an exact match (except for the BRBP bits?  If so, that's 
-        if (match_wo_brbp && match_w__brbp) {
-            // NOTE: This is expected to be impossible, but only way to know is via exhaustively checking all 16-bit values.
-            return SAFEROTP_ECC_ERROR_BRBP_DUAL_DECODINGS_POSSIBLE;
-        } else if (match_wo_brbp) {
+        if (parity_odd) {
+            // Either multiple bits in error, or this data was not encoded with the RP2350 ECC encoding scheme.
+            return SAFEROTP_ECC_ERROR_BRBP_NEITHER_DECODING_VALID;
+        } else if (syndrome == 0u) {
             // There was a single-bit error in the BRBP bits; True value was 0b00  (no BRBP used to store the ECC encoded data).
-            return decoded_wo_brbp;
-        } else if (match_w__brbp) {
+            *flipped_bit = (data.bit_repair_by_polarity == 0x1u) ? 22 : 23; // the set bit is in error
+            return data.as_uint32 & SUCCESS_MASK;
+        } else if (syndrome == SYNDROME_OF_INVERTED_ROW) {
             // There was a single-bit error in the BRBP bits; True value was 0b11  (BRBP used to store the ECC encoded data).
-            return decoded_w__brbp;
+            *flipped_bit = (data.bit_repair_by_polarity == 0x1u) ? 23 : 22; // the unset bit is in error
+            *inverted = true;
+            return ~data.as_uint32 & SUCCESS_MASK;
         } else {
             // Either multiple bits in error, or this data was not encoded with the RP2350 ECC encoding scheme.
             return SAFEROTP_ECC_ERROR_BRBP_NEITHER_DECODING_VALID;
@@ -95,64 +189,15 @@ static uint32_t decode_raw_data_with_correction_impl(const SAFEROTP_RAW_READ_RES
     //     BRBP checks for two ones in bits 23:22.  When both
     //     bits 23 and 22 are set, BRBP inverts the entire row
     //     before passing it to the modified Hamming code stage.
-    const SAFEROTP_RAW_READ_RESULT src = {
-        .as_uint32 =
-            (data.bit_repair_by_polarity == 0x3u) ?
-            (data.as_uint32 ^ 0x00FFFFFFu) :
-            (data.as_uint32)
-    };
-    
-    // 2. re-calculate the six parity bits using lower 16-bits
-    // See section 13.6.2 Modified Hamming ECC @ page 1265
-    //     When you read an OTP value through an ECC alias,
-    //     ECC recalculates the six parity bits based on the
-    //     value read from the OTP row.
-    //     ...
-    SAFEROTP_RAW_READ_RESULT tmp = { .as_uint32 = saferotp_calculate_ecc(src.as_uint32) };
-
-    // 3. Simplest case: do the values match exactly? If so, done!
-    if (tmp.as_uint32 == src.as_uint32) {
-        return src.as_uint32 & SUCCESS_MASK; // SUCCESS!
-    }
-    
-    // 4. XOR the recalculated ECC vs. src bits
-    // See section 13.6.2 Modified Hamming ECC @ page 1265
-    //     ...
-    //     Then, ECC XORs the original six (6) parity bits with
-    //     the newly-calculated parity bits.
-    //
-    //     This generates six (6) new bits:
-    //     • the five (5) LSBs are the syndrome, a unique
-    //       bit pattern that corresponds to each possible
-    //       bit flip in the data value
-    //     • the MSB distinguishes between odd and even
-    //       numbers of bit flips
-    //     ...
-    tmp.as_uint32 ^= src.as_uint32;
-
-    // NEW: if syndrome has exactly one bit set,
-    //      then bit flip was outside the 16 data bits.
-    //      Done!
-    if ((tmp.as_uint32 & (tmp.as_uint32 - 1u)) == 0u) {
-        return src.as_uint32 & SUCCESS_MASK; // SUCCESS!
-    }
-
-    // NEW: Not specified in datasheet ...
-    //      AFTER XOR ... the parity bit needs to flip
-    //      if the low 5 bits have an odd number of set bits?
-    if (_even_parity(tmp.hamming_ecc)) {
-        tmp.parity_bit ^= 1;
-    }
-    // NEW: If syndrome is 0b00001 the single-bit error was in one of the BRBP bits?
-    if (tmp.hamming_ecc == 0x01u) {
-        // NOTE: This is expected to be impossible to reach this code,
-        //       because should have found the one-bit error earlier (above).
-        //       After all, a one-bit error in BRBP is either 0b01 or 0b10,
-        //       both of which checked above.  Belt-and-suspenders....
-        return SAFEROTP_ECC_ERROR_INTERNAL_ERROR_BRBP_BIT;
+    uint32_t value = data.as_uint32;
+    if (data.bit_repair_by_polarity == 0x3u) {
+        value    ^= 0x00FFFFFFu;
+        syndrome ^= SYNDROME_OF_INVERTED_ROW;
+        *inverted = true;
+        // overall parity is unchanged, as 22 bits were inverted
     }
 
-    // 4. Decide result based on the parity & syndrome
+    // 2. Decide result based on the parity & syndrome
     // See section 13.6.2 Modified Hamming ECC @ page 1265
     //     ...
     //     If all 6 bits in this value are zero,
@@ -160,20 +205,27 @@ static uint32_t decode_raw_data_with_correction_impl(const SAFEROTP_RAW_READ_RES
     //     If the MSB is 0, but the syndrome contains a value other than 0,
     //         the ECC detected an unrecoverable multi-bit error.
     //     ...
-    if (tmp.parity_bit == 0u && tmp.hamming_ecc == 0u) {
-        // NOTE: This is expected to be impossible to reach this code,
-        //       because should have discovered no error existed earlier,
-        //       when calculated ECC from just the low 16 bits.
-        //       Even so, belt-and-suspenders... Can this occur any other time?
-        //       would need to check all 2^24 input values to be sure.
-        return SAFEROTP_ECC_ERROR_INTERNAL_ERROR_PERFECT_MATCH;
-    }
-    if (tmp.parity_bit == 0u && tmp.hamming_ecc != 0u) {
+    if (!parity_odd) {
+        if (syndrome == 0u) {
+            return value & SUCCESS_MASK; // SUCCESS!
+        }
+        if (syndrome == 0x01u) {
+            // NOTE: Even number of bit flips, including the lowest ECC bit.
+            //       Kept as a distinct error code for compatibility with prior versions.
+            return SAFEROTP_ECC_ERROR_INTERNAL_ERROR_BRBP_BIT;
+        }
         return SAFEROTP_ECC_ERROR_DETECTED_MULTI_BIT_ERROR;
     }
 
+    // 3. Odd number of bit flips.  If the syndrome has zero or one bit set,
+    //    then the single bit flip was in the parity bit or one of the ECC bits,
+    //    outside the 16 data bits.  Done!
+    if ((syndrome & (syndrome - 1u)) == 0u) {
+        *flipped_bit = (syndrome == 0u) ? 21 : (int8_t)(16 + __builtin_ctz(syndrome));
+        return value & SUCCESS_MASK; // SUCCESS!
+    }
 
-    // 5. Else correct the single-bit error ... the syndrome is the index into the bitflip array.
+    // 4. Else correct the single-bit error ... the syndrome is the index into the bitflip array.
     // See section 13.6.2 Modified Hamming ECC @ page 1265
     //     ...
     //     If the MSB is 1,
@@ -182,27 +234,81 @@ static uint32_t decode_raw_data_with_correction_impl(const SAFEROTP_RAW_READ_RES
     //         ECC flips the corresponding data bit
     //         to recover from the error.
     //     ...
-    uint16_t bitflip = sdk_otp_syndrome_to_bitflip[tmp.hamming_ecc];
+    uint16_t bitflip = sdk_otp_syndrome_to_bitflip[syndrome];
 
     if (bitflip == 0u) {
         // The table has entries for all **VALID** single-bit flip syndromes.
         // All other values in the table are 0u, which would not flip a bit,
         // and thus would not correct an error.
-        // It's unknown if this code path could be reached.
         return SAFEROTP_ECC_ERROR_NOT_VALID_SINGLE_BIT_FLIP;
     }
 
-    return (src.as_uint32 ^ bitflip) & SUCCESS_MASK;
+    *flipped_bit = (int8_t)__builtin_ctz(bitflip);
+    return (value ^ bitflip) & SUCCESS_MASK;
 }
 
 
 
+// Plans how to write `value` to an OTP row that currently holds `existing_raw`.
+// OTP bits can only transition from 0 --> 1, so each candidate encoding (normal
+// or BRBP-inverted) is OR'd with the existing bits, and is only usable if the
+// result still decodes to `value`.  A candidate that leaves no bit errors is
+// always preferred; otherwise (or on a tie) the one burning the fewest new bits.
+static void plan_single_ecc_write(uint32_t existing_raw, uint16_t value, SAFEROTP_ECC_WRITE_PLAN* plan) {
+    enum {
+        MASK_ALL_RAW_BITS = 0xFFFFFFu,
+    };
+    plan->raw_to_write = existing_raw;
+    plan->action       = SAFEROTP_ECC_WRITE_PLAN_IMPOSSIBLE;
+    plan->new_bits     = 0u;
+    plan->inverted     = 0u;
+    plan->reserved     = 0u;
+
+    if ((existing_raw & 0xFF000000u) != 0u) {
+        // existing row could not be read ... never write to it
+        return;
+    }
+    SAFEROTP_ECC_DECODE_DETAILS existing;
+    if (saferotp_decode_raw_with_details(existing_raw, &existing) == value) {
+        // already written, nothing to do for this row
+        plan->action   = SAFEROTP_ECC_WRITE_PLAN_NO_WRITE;
+        plan->inverted = existing.brbp_inverted;
+        return;
+    }
+
+    uint32_t encoded = saferotp_calculate_ecc(value);
+    const uint32_t candidates[2] = { encoded, encoded ^ MASK_ALL_RAW_BITS };
+    uint_fast8_t best_errors   = UINT8_MAX;
+    uint_fast8_t best_new_bits = UINT8_MAX;
+    for (uint_fast8_t i = 0u; i < 2u; ++i) {
+        uint32_t to_write = existing_raw | candidates[i];
+        if (saferotp_decode_raw(to_write) != value) {
+            continue;
+        }
+        uint_fast8_t errors   = (uint_fast8_t)__builtin_popcount(to_write ^ candidates[i]);
+        uint_fast8_t new_bits = (uint_fast8_t)__builtin_popcount(to_write ^ existing_raw);
+        bool better =
+            ((errors == 0u) != (best_errors == 0u)) ? (errors == 0u) :
+            (new_bits < best_new_bits);
+        if (better) {
+            best_errors        = errors;
+            best_new_bits      = new_bits;
+            plan->raw_to_write = to_write;
+            plan->action       = (errors == 0u) ? SAFEROTP_ECC_WRITE_PLAN_WRITE : SAFEROTP_ECC_WRITE_PLAN_WRITE_DEGRADED;
+            plan->new_bits     = (uint8_t)new_bits;
+            plan->inverted     = i;
+        }
+    }
+}
+
+
 // ======================================================================
-// The following are the only two non-static functions in this file.
+// The following are the only non-static functions in this file.
 // everything above are just the implementation details.
 // ======================================================================
 
 
+#if SAFEROTP_ECC_ENCODER == SAFEROTP_ECC_ENCODER_LOOP
 uint32_t saferotp_calculate_ecc(uint16_t x) {
     uint32_t p = x;
     for (uint_fast8_t i = 0; i < 6; ++i) {
@@ -210,43 +316,69 @@ uint32_t saferotp_calculate_ecc(uint16_t x) {
     }
     return p;
 }
+#elif SAFEROTP_ECC_ENCODER == SAFEROTP_ECC_ENCODER_TABLE8
+uint32_t saferotp_calculate_ecc(uint16_t x) {
+    uint32_t ecc_bits = _otp_ecc_bits_lo[x & 0xFFu] ^ _otp_ecc_bits_hi[x >> 8];
+    return x | (ecc_bits << 16);
+}
+#else
+    #error "SAFEROTP_ECC_ENCODER must be either SAFEROTP_ECC_ENCODER_LOOP or SAFEROTP_ECC_ENCODER_TABLE8"
+#endif
 
 uint32_t saferotp_decode_raw(uint32_t raw_data) {
     const SAFEROTP_RAW_READ_RESULT data = { .as_uint32 = raw_data };
     // This function detects as erroneous raw data that the bootrom accepts
-    // as being validly encoded ECC data.  This can occur when the count
-    // of bitflips is 3, 5 (also 19, 21 for BRBP variants) vs. the correct encoding.
-    // It seems bootrom hides ECC errors in many cases ... Thus it appears
-    // to be a best practice to ONLY read OTP in raw form, and then detect
-    // and correct the ECC via software.
-    uint32_t result = decode_raw_data_with_correction_impl(data);
-
-    // if use of syndrome calculates matching low 16 bits,
-    // then final check that original data has <2 bit flips vs.
-    // the ECC encoded value.
+    // as being validly encoded ECC data.  It seems bootrom hides ECC errors
+    // in many cases ... Thus it appears to be a best practice to ONLY read
+    // OTP in raw form, and then detect and correct the ECC via software.
     //
-    // Doing so excludes erroneously accepting encodings with 3 or 5 bit flips,
-    // EVEN WHEN the low 16-bit would end up unchanged.
-    // (also excludes erroneous encodings with 19 or 21 bitflips ... see BRBP.)
-    // As a result, this function provides heightened error detection for the
-    // ECC decoding, vs. an implementation that skips this step.
-    if ((result & 0xFFFF0000u) == 0) {
-        // result could be encoded two ways: with or without use of BRBP
-        uint32_t chk  = saferotp_calculate_ecc(result);
-        uint32_t brbp = chk ^ 0xFFFFFFu;
-        uint32_t chk_bits  = chk  ^ data.as_uint32;
-        uint32_t brbp_bits = brbp ^ data.as_uint32;
-        if ((__builtin_popcount(chk_bits) <= 1) && (data.bit_repair_by_polarity != 0x3u)) {
-            // this is OK
-        } else if ((__builtin_popcount(brbp_bits) <= 1) && (data.bit_repair_by_polarity != 0x0u)) {
-            // this is OK
-        } else {
-            // this is NOT a valid ECC decoding ... but maybe the bootrom will think it is.  :-)
-            return SAFEROTP_ECC_ERROR_POTENTIALLY_READABLE_BY_BOOTROM;
-        }
+    // Prior versions re-encoded the result, and verified the original data
+    // had <2 bit flips vs. the ECC encoded value (with or without BRBP).
+    // Because the syndrome decoding only accepts rows within a single bit
+    // flip of a valid encoding (the modified hamming code has a minimum
+    // distance of four), that check can never fail, and is no longer done.
+    // This was verified exhaustively against all 2^24 raw values.
+    int8_t flipped_bit;
+    bool inverted;
+    return decode_raw_data_with_correction_impl(data, &flipped_bit, &inverted);
+}
+
+uint32_t saferotp_decode_raw_with_details(uint32_t raw_data, SAFEROTP_ECC_DECODE_DETAILS* out_details) {
+    const SAFEROTP_RAW_READ_RESULT data = { .as_uint32 = raw_data };
+    int8_t flipped_bit;
+    bool inverted;
+    uint32_t result = decode_raw_data_with_correction_impl(data, &flipped_bit, &inverted);
+
+    out_details->result        = result;
+    out_details->flipped_bit   = flipped_bit;
+    out_details->brbp_inverted = inverted ? 1u : 0u;
+    out_details->reserved      = 0u;
+    if ((result & 0xFF000000u) != 0u) {
+        out_details->status        = SAFEROTP_ECC_ROW_STATUS_ERROR;
+        out_details->flipped_bit   = -1;
+        out_details->brbp_inverted = 0u;
+    } else if (flipped_bit >= 0) {
+        out_details->status = SAFEROTP_ECC_ROW_STATUS_CORRECTED;
+    } else {
+        out_details->status = SAFEROTP_ECC_ROW_STATUS_CLEAN;
     }
     return result;
 }
+void saferotp_decode_raw_batch_with_details(const uint32_t* raw, SAFEROTP_ECC_DECODE_DETAILS* out_details, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        saferotp_decode_raw_with_details(raw[i], &out_details[i]);
+    }
+}
+size_t saferotp_plan_ecc_writes(const uint32_t* existing_raw, const uint16_t* values, SAFEROTP_ECC_WRITE_PLAN* out_plan, size_t count) {
+    size_t impossible_rows = 0u;
+    for (size_t i = 0; i < count; ++i) {
+        plan_single_ecc_write(existing_raw[i], values[i], &out_plan[i]);
+        if (out_plan[i].action == SAFEROTP_ECC_WRITE_PLAN_IMPOSSIBLE) {
+            ++impossible_rows;
+        }
+    }
+    return impossible_rows;
+}
 
 
 
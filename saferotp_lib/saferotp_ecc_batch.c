@@ -0,0 +1,289 @@
+#include "saferotp_ecc.h"
+
+// Batch versions of saferotp_calculate_ecc() and saferotp_decode_raw().
+//
+// Host tools (manufacturing, audit of OTP images) may decode many thousands
+// of rows at a time.  On x86-64 hosts, these dispatch at runtime to SSE4.1
+// or AVX2 kernels.  All other platforms (including the RP2350) use the
+// portable table-driven loop below.  All paths give bit-identical results
+// to the single-value functions, including the error codes.
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+    #define SAFEROTP_ECC_BATCH_X86 1
+    #include <immintrin.h>
+#else
+    #define SAFEROTP_ECC_BATCH_X86 0
+#endif
+
+// Re-encoding the low 16 bits of a raw row, and XOR'ing with the raw row,
+// gives the datasheet's "syndrome" byte in bits 16..23: five hamming bits,
+// the parity difference, and the two (unchanged) BRBP bits.  Because the
+// encoding is linear, the decoding only depends on that byte, and a
+// successful decoding is always the raw data XOR'd with a fixed mask.
+//
+// Each entry is therefore either:
+// * an error code (top 8 bits non-zero), or
+// * the mask to XOR with the low 16 bits of the raw data
+//
+// _otp_ecc_decode_actions[i] == saferotp_decode_raw(i << 16)
+static const uint32_t _otp_ecc_decode_actions[256] = {
+    0x00000000u, 0x00000000u, 0x00000000u, 0x7F020000u, 0x00000000u, 0x7F020000u, 0x7F020000u, 0x00000008u, // [0x00..0x07]
+    0x00000000u, 0x7F020000u, 0x7F020000u, 0x00000040u, 0x7F020000u, 0x00000100u, 0x00000200u, 0x7F020000u, // [0x08..0x0F]
+    0x00000000u, 0x7F020000u, 0x7F020000u, 0x00002000u, 0x7F020000u, 0x00008000u, 0x7F050000u, 0x7F020000u, // [0x10..0x17]
+    0x7F020000u, 0x7F050000u, 0x7F050000u, 0x7F020000u, 0x7F050000u, 0x7F020000u, 0x7F020000u, 0x7F050000u, // [0x18..0x1F]
+    0x00000000u, 0x40010000u, 0x7F020000u, 0x00000001u, 0x7F020000u, 0x00000002u, 0x00000004u, 0x7F020000u, // [0x20..0x27]
+    0x7F020000u, 0x00000010u, 0x00000020u, 0x7F020000u, 0x00000080u, 0x7F020000u, 0x7F020000u, 0x00000400u, // [0x28..0x2F]
+    0x7F020000u, 0x00000800u, 0x00001000u, 0x7F020000u, 0x00004000u, 0x7F020000u, 0x7F020000u, 0x7F050000u, // [0x30..0x37]
+    0x7F050000u, 0x7F020000u, 0x7F020000u, 0x7F050000u, 0x7F020000u, 0x7F050000u, 0x7F050000u, 0x7F020000u, // [0x38..0x3F]
+    0x00000000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, // [0x40..0x47]
+    0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, // [0x48..0x4F]
+    0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, // [0x50..0x57]
+    0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, // [0x58..0x5F]
+    0x7F030000u, 0x0000FFFFu, 0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, // [0x60..0x67]
+    0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, // [0x68..0x6F]
+    0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, // [0x70..0x77]
+    0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, // [0x78..0x7F]
+    0x00000000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, // [0x80..0x87]
+    0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, // [0x88..0x8F]
+    0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, // [0x90..0x97]
+    0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, // [0x98..0x9F]
+    0x7F030000u, 0x0000FFFFu, 0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, // [0xA0..0xA7]
+    0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, // [0xA8..0xAF]
+    0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, // [0xB0..0xB7]
+    0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, 0x7F030000u, // [0xB8..0xBF]
+    0x40010000u, 0x0000FFFFu, 0x0000FFFEu, 0x7F020000u, 0x0000FFFDu, 0x7F020000u, 0x7F020000u, 0x0000FFFBu, // [0xC0..0xC7]
+    0x0000FFEFu, 0x7F020000u, 0x7F020000u, 0x0000FFDFu, 0x7F020000u, 0x0000FF7Fu, 0x0000FBFFu, 0x7F020000u, // [0xC8..0xCF]
+    0x0000F7FFu, 0x7F020000u, 0x7F020000u, 0x0000EFFFu, 0x7F020000u, 0x0000BFFFu, 0x7F050000u, 0x7F020000u, // [0xD0..0xD7]
+    0x7F020000u, 0x7F050000u, 0x7F050000u, 0x7F020000u, 0x7F050000u, 0x7F020000u, 0x7F020000u, 0x7F050000u, // [0xD8..0xDF]
+    0x0000FFFFu, 0x0000FFFFu, 0x7F020000u, 0x0000FFFFu, 0x7F020000u, 0x0000FFFFu, 0x0000FFF7u, 0x7F020000u, // [0xE0..0xE7]
+    0x7F020000u, 0x0000FFFFu, 0x0000FFBFu, 0x7F020000u, 0x0000FEFFu, 0x7F020000u, 0x7F020000u, 0x0000FDFFu, // [0xE8..0xEF]
+    0x7F020000u, 0x0000FFFFu, 0x0000DFFFu, 0x7F020000u, 0x00007FFFu, 0x7F020000u, 0x7F020000u, 0x7F050000u, // [0xF0..0xF7]
+    0x7F050000u, 0x7F020000u, 0x7F020000u, 0x7F050000u, 0x7F020000u, 0x7F050000u, 0x7F050000u, 0x7F020000u, // [0xF8..0xFF]
+};
+
+// ECC bits (bits 16..21 of saferotp_calculate_ecc() result) for each nibble
+// of the 16-bit value.  The ECC bits of the full value are the XOR of the four.
+// _otp_ecc_nibble_bits[k][v] == (saferotp_calculate_ecc(v << (4*k)) >> 16)
+static const uint8_t _otp_ecc_nibble_bits[4][16] __attribute__((aligned(16))) = {
+    { 0x00u, 0x23u, 0x25u, 0x06u, 0x26u, 0x05u, 0x03u, 0x20u, 0x07u, 0x24u, 0x22u, 0x01u, 0x21u, 0x02u, 0x04u, 0x27u }, // nibble 0
+    { 0x00u, 0x29u, 0x2Au, 0x03u, 0x0Bu, 0x22u, 0x21u, 0x08u, 0x2Cu, 0x05u, 0x06u, 0x2Fu, 0x27u, 0x0Eu, 0x0Du, 0x24u }, // nibble 1
+    { 0x00u, 0x0Du, 0x0Eu, 0x03u, 0x2Fu, 0x22u, 0x21u, 0x2Cu, 0x31u, 0x3Cu, 0x3Fu, 0x32u, 0x1Eu, 0x13u, 0x10u, 0x1Du }, // nibble 2
+    { 0x00u, 0x32u, 0x13u, 0x21u, 0x34u, 0x06u, 0x27u, 0x15u, 0x15u, 0x27u, 0x06u, 0x34u, 0x21u, 0x13u, 0x32u, 0x00u }, // nibble 3
+};
+
+static inline uint32_t decode_raw_via_action_table(uint32_t raw) {
+    if (raw & 0xFF000000u) {
+        return SAFEROTP_ECC_ERROR_INVALID_INPUT;
+    }
+    uint32_t syndrome_byte = ((saferotp_calculate_ecc((uint16_t)raw) ^ raw) >> 16) & 0xFFu;
+    uint32_t action = _otp_ecc_decode_actions[syndrome_byte];
+    if (action & 0xFF000000u) {
+        return action;
+    }
+    return (raw ^ action) & 0x0000FFFFu;
+}
+// The portable path is deliberately not word-parallel (SWAR).  A raw row already
+// fills a 32-bit word, so there are no spare lanes on the RP2350's M33; the only
+// word-wide option is the bit-sliced engine (saferotp_decode_raw_page()), and on a
+// scalar host that measured ~7x slower than this loop (decode ~15 vs ~2.3 ns/row,
+// encode ~10.5 vs ~1.1 ns/row).  One table lookup per row is the fastest portable
+// form; compare with `saferotp_ecc_verify --bench` (tools/) before changing it.
+static void decode_raw_batch_portable(const uint32_t* raw, uint32_t* out, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = decode_raw_via_action_table(raw[i]);
+    }
+}
+static void calculate_ecc_batch_portable(const uint16_t* values, uint32_t* out, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = saferotp_calculate_ecc(values[i]);
+    }
+}
+
+#if SAFEROTP_ECC_BATCH_X86
+#pragma region    // x86-64 SSE4.1 kernels (four rows at a time)
+
+// Returns the ECC bits (as bits 0..5 of each 32-bit lane) for the low 16 bits of each lane.
+__attribute__((target("sse4.1")))
+static inline __m128i ecc_bits_sse41(__m128i values) {
+    const __m128i nibble_mask = _mm_set1_epi8(0x0F);
+    const __m128i n0 = _mm_load_si128((const __m128i*)_otp_ecc_nibble_bits[0]);
+    const __m128i n1 = _mm_load_si128((const __m128i*)_otp_ecc_nibble_bits[1]);
+    const __m128i n2 = _mm_load_si128((const __m128i*)_otp_ecc_nibble_bits[2]);
+    const __m128i n3 = _mm_load_si128((const __m128i*)_otp_ecc_nibble_bits[3]);
+    __m128i lo = _mm_and_si128(values, nibble_mask);
+    __m128i hi = _mm_and_si128(_mm_srli_epi32(values, 4), nibble_mask);
+    // byte 0 of each lane holds the low data byte, byte 1 holds the high data byte
+    __m128i low_byte  = _mm_xor_si128(_mm_shuffle_epi8(n0, lo), _mm_shuffle_epi8(n1, hi));
+    __m128i high_byte = _mm_xor_si128(_mm_shuffle_epi8(n2, lo), _mm_shuffle_epi8(n3, hi));
+    __m128i bits = _mm_xor_si128(low_byte, _mm_srli_epi32(high_byte, 8));
+    return _mm_and_si128(bits, _mm_set1_epi32(0xFF));
+}
+__attribute__((target("sse4.1")))
+static void calculate_ecc_batch_sse41(const uint16_t* values, uint32_t* out, size_t n) {
+    size_t i = 0;
+    for (; i + 4u <= n; i += 4u) {
+        __m128i v = _mm_cvtepu16_epi32(_mm_loadl_epi64((const __m128i*)(values + i)));
+        __m128i r = _mm_or_si128(v, _mm_slli_epi32(ecc_bits_sse41(v), 16));
+        _mm_storeu_si128((__m128i*)(out + i), r);
+    }
+    calculate_ecc_batch_portable(values + i, out + i, n - i);
+}
+__attribute__((target("sse4.1")))
+static void decode_raw_batch_sse41(const uint32_t* raw, uint32_t* out, size_t n) {
+    const __m128i top_byte_mask = _mm_set1_epi32((int)0xFF000000u);
+    const __m128i zero = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 4u <= n; i += 4u) {
+        __m128i r = _mm_loadu_si128((const __m128i*)(raw + i));
+        __m128i syndrome_byte = _mm_and_si128(
+            _mm_xor_si128(ecc_bits_sse41(r), _mm_srli_epi32(r, 16)),
+            _mm_set1_epi32(0xFF)
+        );
+        // SSE4.1 has no gather ... the four table lookups are done individually
+        __m128i action = _mm_setr_epi32(
+            (int)_otp_ecc_decode_actions[_mm_extract_epi32(syndrome_byte, 0)],
+            (int)_otp_ecc_decode_actions[_mm_extract_epi32(syndrome_byte, 1)],
+            (int)_otp_ecc_decode_actions[_mm_extract_epi32(syndrome_byte, 2)],
+            (int)_otp_ecc_decode_actions[_mm_extract_epi32(syndrome_byte, 3)]
+        );
+        __m128i is_success = _mm_cmpeq_epi32(_mm_and_si128(action, top_byte_mask), zero);
+        __m128i is_valid   = _mm_cmpeq_epi32(_mm_and_si128(r,      top_byte_mask), zero);
+        __m128i corrected  = _mm_and_si128(_mm_xor_si128(r, action), _mm_set1_epi32(0xFFFF));
+        __m128i result = _mm_blendv_epi8(action, corrected, is_success);
+        result = _mm_blendv_epi8(_mm_set1_epi32((int)SAFEROTP_ECC_ERROR_INVALID_INPUT), result, is_valid);
+        _mm_storeu_si128((__m128i*)(out + i), result);
+    }
+    decode_raw_batch_portable(raw + i, out + i, n - i);
+}
+#pragma endregion // x86-64 SSE4.1 kernels (four rows at a time)
+#pragma region    // x86-64 AVX2 kernels (eight rows at a time)
+
+__attribute__((target("avx2")))
+static inline __m256i ecc_bits_avx2(__m256i values) {
+    const __m256i nibble_mask = _mm256_set1_epi8(0x0F);
+    const __m256i n0 = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i*)_otp_ecc_nibble_bits[0]));
+    const __m256i n1 = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i*)_otp_ecc_nibble_bits[1]));
+    const __m256i n2 = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i*)_otp_ecc_nibble_bits[2]));
+    const __m256i n3 = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i*)_otp_ecc_nibble_bits[3]));
+    __m256i lo = _mm256_and_si256(values, nibble_mask);
+    __m256i hi = _mm256_and_si256(_mm256_srli_epi32(values, 4), nibble_mask);
+    __m256i low_byte  = _mm256_xor_si256(_mm256_shuffle_epi8(n0, lo), _mm256_shuffle_epi8(n1, hi));
+    __m256i high_byte = _mm256_xor_si256(_mm256_shuffle_epi8(n2, lo), _mm256_shuffle_epi8(n3, hi));
+    __m256i bits = _mm256_xor_si256(low_byte, _mm256_srli_epi32(high_byte, 8));
+    return _mm256_and_si256(bits, _mm256_set1_epi32(0xFF));
+}
+__attribute__((target("avx2")))
+static void calculate_ecc_batch_avx2(const uint16_t* values, uint32_t* out, size_t n) {
+    size_t i = 0;
+    for (; i + 8u <= n; i += 8u) {
+        __m256i v = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)(values + i)));
+        __m256i r = _mm256_or_si256(v, _mm256_slli_epi32(ecc_bits_avx2(v), 16));
+        _mm256_storeu_si256((__m256i*)(out + i), r);
+    }
+    calculate_ecc_batch_portable(values + i, out + i, n - i);
+}
+__attribute__((target("avx2")))
+static void decode_raw_batch_avx2(const uint32_t* raw, uint32_t* out, size_t n) {
+    const __m256i top_byte_mask = _mm256_set1_epi32((int)0xFF000000u);
+    const __m256i zero = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 8u <= n; i += 8u) {
+        __m256i r = _mm256_loadu_si256((const __m256i*)(raw + i));
+        __m256i syndrome_byte = _mm256_and_si256(
+            _mm256_xor_si256(ecc_bits_avx2(r), _mm256_srli_epi32(r, 16)),
+            _mm256_set1_epi32(0xFF)
+        );
+        __m256i action = _mm256_i32gather_epi32((const int*)_otp_ecc_decode_actions, syndrome_byte, 4);
+        __m256i is_success = _mm256_cmpeq_epi32(_mm256_and_si256(action, top_byte_mask), zero);
+        __m256i is_valid   = _mm256_cmpeq_epi32(_mm256_and_si256(r,      top_byte_mask), zero);
+        __m256i corrected  = _mm256_and_si256(_mm256_xor_si256(r, action), _mm256_set1_epi32(0xFFFF));
+        __m256i result = _mm256_blendv_epi8(action, corrected, is_success);
+        result = _mm256_blendv_epi8(_mm256_set1_epi32((int)SAFEROTP_ECC_ERROR_INVALID_INPUT), result, is_valid);
+        _mm256_storeu_si256((__m256i*)(out + i), result);
+    }
+    decode_raw_batch_portable(raw + i, out + i, n - i);
+}
+#pragma endregion // x86-64 AVX2 kernels (eight rows at a time)
+#endif // SAFEROTP_ECC_BATCH_X86
+
+
+// ======================================================================
+// The following are the only non-static functions in this file.
+// everything above are just the implementation details.
+// ======================================================================
+
+void saferotp_calculate_ecc_batch(const uint16_t* values, uint32_t* out, size_t count) {
+#if SAFEROTP_ECC_BATCH_X86
+    if (__builtin_cpu_supports("avx2")) {
+        calculate_ecc_batch_avx2(values, out, count);
+        return;
+    }
+    if (__builtin_cpu_supports("sse4.1")) {
+        calculate_ecc_batch_sse41(values, out, count);
+        return;
+    }
+#endif
+    calculate_ecc_batch_portable(values, out, count);
+}
+
+void saferotp_decode_raw_batch(const uint32_t* raw, uint32_t* out, size_t count) {
+#if SAFEROTP_ECC_BATCH_X86
+    if (__builtin_cpu_supports("avx2")) {
+        decode_raw_batch_avx2(raw, out, count);
+        return;
+    }
+    if (__builtin_cpu_supports("sse4.1")) {
+        decode_raw_batch_sse41(raw, out, count);
+        return;
+    }
+#endif
+    decode_raw_batch_portable(raw, out, count);
+}
+
+bool saferotp_calculate_ecc_batch_kernel(uint8_t kernel, const uint16_t* values, uint32_t* out, size_t count) {
+    switch (kernel) {
+        case SAFEROTP_ECC_BATCH_KERNEL_PORTABLE:
+            calculate_ecc_batch_portable(values, out, count);
+            return true;
+#if SAFEROTP_ECC_BATCH_X86
+        case SAFEROTP_ECC_BATCH_KERNEL_SSE41:
+            if (__builtin_cpu_supports("sse4.1")) {
+                calculate_ecc_batch_sse41(values, out, count);
+                return true;
+            }
+            return false;
+        case SAFEROTP_ECC_BATCH_KERNEL_AVX2:
+            if (__builtin_cpu_supports("avx2")) {
+                calculate_ecc_batch_avx2(values, out, count);
+                return true;
+            }
+            return false;
+#endif
+        default:
+            return false;
+    }
+}
+
+bool saferotp_decode_raw_batch_kernel(uint8_t kernel, const uint32_t* raw, uint32_t* out, size_t count) {
+    switch (kernel) {
+        case SAFEROTP_ECC_BATCH_KERNEL_PORTABLE:
+            decode_raw_batch_portable(raw, out, count);
+            return true;
+#if SAFEROTP_ECC_BATCH_X86
+        case SAFEROTP_ECC_BATCH_KERNEL_SSE41:
+            if (__builtin_cpu_supports("sse4.1")) {
+                decode_raw_batch_sse41(raw, out, count);
+                return true;
+            }
+            return false;
+        case SAFEROTP_ECC_BATCH_KERNEL_AVX2:
+            if (__builtin_cpu_supports("avx2")) {
+                decode_raw_batch_avx2(raw, out, count);
+                return true;
+            }
+            return false;
+#endif
+        default:
+            return false;
+    }
+}
@@ -0,0 +1,194 @@
+#include "saferotp_ecc.h"
+
+// Bit-sliced ECC encoding / decoding, 32 rows at a time.
+//
+// The 32 rows are transposed into bit-planes: plane `b` holds bit `b`
+// of every row, with each row in its own bit position.  The syndrome,
+// BRBP checks, single-bit correction and error classification are then
+// plain 32-bit logic operations on the planes, processing all 32 rows
+// at once.  There are no data-dependent branches or table lookups, so
+// the execution time does not depend on the data being decoded.
+//
+// The per-row results are identical to saferotp_calculate_ecc() and
+// saferotp_decode_raw(), including the error codes.
+
+#define xROWS_PER_BLOCK 32u
+
+// Each of the five hamming_ecc bits covers these data bits.
+// (Same as the parity table in saferotp_ecc.c)
+static const uint32_t _bitslice_ecc_data_masks[5] = {
+    0x00AD5Bu,
+    0x00366Du,
+    0x00C78Eu,
+    0x0007F0u,
+    0x00F800u,
+};
+// The syndrome that each data bit produces when flipped.
+// (Inverse of the syndrome to bitflip table in saferotp_ecc.c)
+static const uint8_t _bitslice_data_bit_syndrome[16] = {
+     3u,  5u,  6u,  7u,  9u, 10u, 11u, 12u,
+    13u, 14u, 15u, 17u, 18u, 19u, 20u, 21u,
+};
+static_assert(sizeof(_bitslice_data_bit_syndrome) == 16u, "one syndrome per data bit");
+
+// Transposes a 32x32 bit matrix in place.  Applying it twice restores the original.
+// After the transpose, plane `b` is at index (31-b), and row `r` is at bit (31-r).
+// See Hacker's Delight, 2nd edition, section 7-3.
+static void transpose32(uint32_t a[xROWS_PER_BLOCK]) {
+    uint32_t m = 0x0000FFFFu;
+    for (uint_fast8_t j = 16u; j != 0u; j >>= 1, m ^= (m << j)) {
+        for (uint_fast8_t k = 0u; k < xROWS_PER_BLOCK; k = (k + j + 1u) & ~j) {
+            uint32_t t = (a[k] ^ (a[k + j] >> j)) & m;
+            a[k]     ^= t;
+            a[k + j] ^= (t << j);
+        }
+    }
+}
+#define PLANE(a, bit) ((a)[31u - (bit)])
+
+// XOR of all planes selected by the mask
+static inline uint32_t plane_parity(const uint32_t planes[xROWS_PER_BLOCK], uint32_t mask) {
+    uint32_t result = 0u;
+    for (uint_fast8_t b = 0u; b < 24u; ++b) {
+        // the mask is a constant, not data ... no data-dependent branch
+        if (mask & (1u << b)) {
+            result ^= PLANE(planes, b);
+        }
+    }
+    return result;
+}
+// All-ones for each row whose syndrome equals the constant `value`
+static inline uint32_t syndrome_equals(const uint32_t syndrome[5], uint32_t value) {
+    uint32_t result = 0xFFFFFFFFu;
+    for (uint_fast8_t i = 0u; i < 5u; ++i) {
+        result &= (value & (1u << i)) ? syndrome[i] : ~syndrome[i];
+    }
+    return result;
+}
+// ORs `code` into the output planes for each row in `rows`
+static inline void set_result_code(uint32_t out[xROWS_PER_BLOCK], uint32_t rows, uint32_t code) {
+    for (uint_fast8_t b = 16u; b < 32u; ++b) {
+        if (code & (1u << b)) {
+            PLANE(out, b) |= rows;
+        }
+    }
+}
+
+static void decode_x32(const uint32_t raw[xROWS_PER_BLOCK], uint32_t out[xROWS_PER_BLOCK]) {
+    uint32_t planes[xROWS_PER_BLOCK];
+    for (uint_fast8_t r = 0u; r < xROWS_PER_BLOCK; ++r) {
+        planes[r] = raw[r];
+    }
+    transpose32(planes);
+
+    // Input must be limited to 24-bit values
+    uint32_t invalid_input = 0u;
+    for (uint_fast8_t b = 24u; b < 32u; ++b) {
+        invalid_input |= PLANE(planes, b);
+    }
+
+    // Syndrome and overall parity, directly from the raw bits (see saferotp_ecc.c)
+    uint32_t syndrome[5];
+    for (uint_fast8_t i = 0u; i < 5u; ++i) {
+        syndrome[i] = plane_parity(planes, _bitslice_ecc_data_masks[i] | (1u << (16u + i)));
+    }
+    uint32_t parity_odd = plane_parity(planes, 0x3FFFFFu);
+
+    uint32_t brbp_lo  = PLANE(planes, 22u);
+    uint32_t brbp_hi  = PLANE(planes, 23u);
+    uint32_t brbp_one = brbp_lo ^ brbp_hi; // only one BRBP bit set
+    uint32_t brbp_two = brbp_lo & brbp_hi; // both BRBP bits set ... invert the row
+
+    // 0. only one BRBP bit set: must be an exact match, either as stored or inverted
+    uint32_t one_as_stored = brbp_one & ~parity_odd & syndrome_equals(syndrome, 0x00u);
+    uint32_t one_inverted  = brbp_one & ~parity_odd & syndrome_equals(syndrome, 0x01u);
+    uint32_t err_brbp_neither = brbp_one & ~(one_as_stored | one_inverted);
+
+    // 1. both BRBP bits set: inverting the row only flips the lowest syndrome bit
+    syndrome[0] ^= brbp_two;
+    uint32_t zero_or_one_bit_syndrome;
+    do {
+        uint32_t seen = 0u, two_or_more = 0u;
+        for (uint_fast8_t i = 0u; i < 5u; ++i) {
+            two_or_more |= seen & syndrome[i];
+            seen        |= syndrome[i];
+        }
+        zero_or_one_bit_syndrome = ~two_or_more;
+    } while (0);
+
+    // 2. even number of bit flips
+    uint32_t even = ~brbp_one & ~parity_odd;
+    uint32_t err_brbp_bit  = even & syndrome_equals(syndrome, 0x01u);
+    uint32_t err_multi_bit = even & ~syndrome_equals(syndrome, 0x00u) & ~err_brbp_bit;
+
+    // 3. odd number of bit flips: correct a single data bit, if the syndrome indicates one
+    uint32_t odd = ~brbp_one & parity_odd;
+    uint32_t flip[16];
+    uint32_t any_flip = 0u;
+    for (uint_fast8_t j = 0u; j < 16u; ++j) {
+        flip[j] = odd & syndrome_equals(syndrome, _bitslice_data_bit_syndrome[j]);
+        any_flip |= flip[j];
+    }
+    uint32_t err_not_valid_flip = odd & ~zero_or_one_bit_syndrome & ~any_flip;
+
+    // 4. assemble the output planes
+    uint32_t invert = one_inverted | brbp_two;
+    uint32_t valid  = ~invalid_input;
+    err_brbp_neither   &= valid;
+    err_brbp_bit       &= valid;
+    err_multi_bit      &= valid;
+    err_not_valid_flip &= valid;
+    uint32_t any_error = invalid_input | err_brbp_neither | err_brbp_bit | err_multi_bit | err_not_valid_flip;
+
+    for (uint_fast8_t b = 0u; b < 16u; ++b) {
+        PLANE(out, b) = (PLANE(planes, b) ^ invert ^ flip[b]) & ~any_error;
+    }
+    for (uint_fast8_t b = 16u; b < 32u; ++b) {
+        PLANE(out, b) = 0u;
+    }
+    set_result_code(out, invalid_input,      SAFEROTP_ECC_ERROR_INVALID_INPUT);
+    set_result_code(out, err_brbp_neither,   SAFEROTP_ECC_ERROR_BRBP_NEITHER_DECODING_VALID);
+    set_result_code(out, err_brbp_bit,       SAFEROTP_ECC_ERROR_INTERNAL_ERROR_BRBP_BIT);
+    set_result_code(out, err_multi_bit,      SAFEROTP_ECC_ERROR_DETECTED_MULTI_BIT_ERROR);
+    set_result_code(out, err_not_valid_flip, SAFEROTP_ECC_ERROR_NOT_VALID_SINGLE_BIT_FLIP);
+
+    transpose32(out);
+}
+
+static void encode_x32(const uint16_t values[xROWS_PER_BLOCK], uint32_t out[xROWS_PER_BLOCK]) {
+    for (uint_fast8_t r = 0u; r < xROWS_PER_BLOCK; ++r) {
+        out[r] = values[r];
+    }
+    transpose32(out);
+
+    uint32_t parity = plane_parity(out, 0xFFFFu);
+    for (uint_fast8_t i = 0u; i < 5u; ++i) {
+        uint32_t ecc_bit = plane_parity(out, _bitslice_ecc_data_masks[i]);
+        PLANE(out, 16u + i) = ecc_bit;
+        parity ^= ecc_bit;
+    }
+    PLANE(out, 21u) = parity;
+
+    transpose32(out);
+}
+
+
+// ======================================================================
+// The following are the only non-static functions in this file.
+// everything above are just the implementation details.
+// ======================================================================
+
+void saferotp_calculate_ecc_x32(const uint16_t values[32], uint32_t out[32]) {
+    encode_x32(values, out);
+}
+void saferotp_decode_raw_x32(const uint32_t raw[32], uint32_t out[32]) {
+    decode_x32(raw, out);
+}
+void saferotp_calculate_ecc_page(const uint16_t values[64], uint32_t out[64]) {
+    encode_x32(values,                   out);
+    encode_x32(values + xROWS_PER_BLOCK, out + xROWS_PER_BLOCK);
+}
+void saferotp_decode_raw_page(const uint32_t raw[64], uint32_t out[64]) {
+    decode_x32(raw,                   out);
+    decode_x32(raw + xROWS_PER_BLOCK, out + xROWS_PER_BLOCK);
+}
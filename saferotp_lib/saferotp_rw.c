@@ -7,6 +7,10 @@
 #include <string.h>
 #include <assert.h>
 #include "pico/bootrom.h" // required for rom_func_otp_access()
+#include "hardware/sync.h" // spin lock for the raw row cache, so both cores may use the library
+#include "pico/mutex.h" // recursive_mutex_t, which yields (rather than spins) while a write is in progress
+#include "hardware/timer.h" // time_us_64(), busy_wait_us_32() for lock timeouts / backoff
+#include "pico/bootrom/lock.h" // bootrom_try_acquire_lock(), BOOTROM_LOCK_OTP
 
 #include "saferotp.h"
 #include "saferotp_ecc.h"
@@ -36,13 +40,21 @@ static bool virt_write_raw_otp_wrapper(uint16_t starting_row, const void* buffer
 static bool virt_read_raw_otp_wrapper(uint16_t starting_row, void* buffer, size_t buffer_size);
 static bool write_raw_wrapper(uint16_t starting_row, const void* buffer, size_t buffer_size);
 static bool read_raw_wrapper(uint16_t starting_row, void* buffer, size_t buffer_size);
+static bool read_raw_rows_with_fallback(uint16_t start_row, uint32_t* out_raw, size_t row_count);
 static bool read_single_otp_ecc_row(uint16_t row, uint16_t * data_out);
 static bool write_single_otp_ecc_row(uint16_t row, uint16_t data);
 static bool write_single_otp_raw_row(uint16_t row, uint32_t data);
 static bool read_single_otp_value_N_of_M(uint16_t start_row, uint8_t N, uint8_t M, uint32_t* out_data);
 static bool write_single_otp_value_N_of_M(uint16_t start_row, uint8_t N, uint8_t M, uint32_t new_value);
+static bool read_otp_N_of_M_data(uint16_t start_row, uint8_t N, uint8_t M, uint32_t* out_values, size_t group_count);
+static bool write_otp_N_of_M_data(uint16_t start_row, uint8_t N, uint8_t M, const uint32_t* new_values, size_t group_count);
 static bool read_otp_byte_3x(uint16_t row, uint8_t* out_data);
 static bool write_otp_byte_3x(uint16_t row, uint8_t new_value);
+static bool read_otp_byte_3x_data(uint16_t start_row, uint8_t* out_data, size_t count_of_bytes);
+static bool write_otp_byte_3x_data(uint16_t start_row, const uint8_t* data, size_t count_of_bytes);
+static bool write_otp_ecc_data_planned(uint16_t start_row, const void* data, size_t count_of_bytes);
+static bool read_otp_ecc_rs_blob(uint16_t start_row, void* out_data, size_t count_of_bytes, uint8_t parity_rows);
+static bool write_otp_ecc_rs_blob(uint16_t start_row, const void* data, size_t count_of_bytes, uint8_t parity_rows);
 #pragma endregion // internal static function prototypes
 
 // BUGBUG / TODO: enable "virtual" OTP, by writing to memory buffer instead of OTP fuses,
@@ -56,9 +68,178 @@ typedef struct _BP_VIRTUALIZED_OTP_BUFFER {
 static BP_VIRTUALIZED_OTP_BUFFER g_virtual_otp = { 0 };
 static bool g_virtual_otp_initialized = false;
 
+// Both RP2350 cores (and RTOS tasks) may use the library at the same time:
+// * Every read-modify-write of OTP rows (plan, program, verify) holds the RMW mutex,
+//   so writes are serialized.  Programming fuses is slow, so this is an SDK (recursive)
+//   mutex: waiting for it sleeps, or yields to the RTOS scheduler, instead of spinning,
+//   and a task preempted while holding it does not deadlock the other tasks.
+//   Reads never take the RMW mutex.
+// * g_otp_write_seq is odd while write_raw_wrapper() is changing rows (RMW mutex held).
+//   For virtualized OTP, that is a short memory update with interrupts disabled, so
+//   the lock-free reads of the virtualized OTP (which wait for an odd count to become
+//   even, and retry if a write changed rows during the copy) never wait on their own core.
+//   Raw row cache fills never wait: they are discarded if a write started after the
+//   rows were read.
+// * The raw row cache uses a spin lock, held only for a short lookup / update,
+//   with interrupts disabled.
+// The write functions must not be called from interrupt handlers.  Reads must not be
+// called from an interrupt handler while a write is in progress on the same core,
+// as the bootrom's OTP access cannot be re-entered.
+//
+// saferotp_lock_acquire() takes only the RMW mutex, with a timeout and exponential backoff,
+// and holds it until saferotp_lock_release(), so a bulk operation costs a single acquisition.
+// BOOTLOCK2 (the bootrom's OTP lock) is never held across a bootrom call: the SDK's
+// rom_func_otp_access() wrapper takes it for the duration of each call, when the SDK is
+// built with bootrom locking.  If the bootrom still reports BOOTROM_ERROR_LOCK_REQUIRED,
+// another user held BOOTLOCK2 at that moment, so the call is retried with backoff.
+// While the caller holds saferotp_lock_acquire(), each call is retried for at most that
+// call's `timeout_us`, and giving up is recorded for saferotp_lock_last_status().
+auto_init_recursive_mutex(g_otp_rmw_mutex);
+static uint8_t g_otp_locks_state = 0u; // 0 == not claimed, 1 == being claimed, 2 == ready
+static spin_lock_t * g_otp_cache_lock = NULL;
+static spin_lock_t * g_otp_async_lock = NULL; // serializes saferotp_async_write() callers
+static uint32_t g_otp_write_seq = 0u;
+static lock_owner_id_t g_otp_lock_owner = LOCK_INVALID_OWNER_ID; // holder of saferotp_lock_acquire()
+static uint32_t g_otp_lock_timeout_us = 0u; // holder's budget to wait for BOOTLOCK2, per bootrom call
+static uint8_t g_otp_lock_last_status = SAFEROTP_LOCK_STATUS_OK; // holder's bootrom calls since saferotp_lock_acquire()
+
+static void otp_locks_init(void) {
+    uint8_t expected = 0u;
+    if (__atomic_compare_exchange_n(&g_otp_locks_state, &expected, 1u, false, __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE)) {
+        g_otp_cache_lock = spin_lock_instance(spin_lock_claim_unused(true));
+        g_otp_async_lock = spin_lock_instance(spin_lock_claim_unused(true));
+        __atomic_store_n(&g_otp_locks_state, 2u, __ATOMIC_RELEASE);
+    }
+    while (__atomic_load_n(&g_otp_locks_state, __ATOMIC_ACQUIRE) != 2u) {
+        tight_loop_contents(); // other core is claiming the spin lock
+    }
+}
+// Only the owner ever stores its own id, so a relaxed load is sufficient
+static bool otp_lock_held_by_caller(void) {
+    return __atomic_load_n(&g_otp_lock_owner, __ATOMIC_RELAXED) == lock_get_caller_owner_id();
+}
+// Recursive, so this nests inside saferotp_lock_acquire() without waiting
+static void otp_rmw_lock(void) {
+    recursive_mutex_enter_blocking(&g_otp_rmw_mutex);
+}
+static void otp_rmw_unlock(void) {
+    recursive_mutex_exit(&g_otp_rmw_mutex);
+}
+// Maximum delay between attempts to acquire the RMW mutex, or to retry a bootrom call
+// rejected with BOOTROM_ERROR_LOCK_REQUIRED (the delay doubles from 1us after each attempt)
+#ifndef SAFEROTP_LOCK_MAX_BACKOFF_US
+    #define SAFEROTP_LOCK_MAX_BACKOFF_US 64u
+#endif
+static_assert(SAFEROTP_LOCK_MAX_BACKOFF_US >= 1u, "SAFEROTP_LOCK_MAX_BACKOFF_US must be at least 1");
+// Total time a bootrom call is retried while BOOTLOCK2 is held elsewhere, before the error is
+// returned (unless the caller holds saferotp_lock_acquire(), which sets its own budget)
+#define xBOOTROM_LOCK_RETRY_US 100000u
+static uint32_t otp_next_backoff_us(uint32_t backoff_us) {
+    backoff_us *= 2u;
+    return (backoff_us > SAFEROTP_LOCK_MAX_BACKOFF_US) ? SAFEROTP_LOCK_MAX_BACKOFF_US : backoff_us;
+}
+// Waits up to `delay_us`, but never past `deadline`.  Returns false once the deadline has passed.
+static bool otp_backoff_until(uint64_t deadline, uint32_t delay_us) {
+    uint64_t now = time_us_64();
+    if (now >= deadline) {
+        return false;
+    }
+    if (delay_us > deadline - now) {
+        delay_us = (uint32_t)(deadline - now);
+    }
+    busy_wait_us_32(delay_us);
+    return true;
+}
+static uint8_t otp_lock_acquire(uint32_t timeout_us) {
+    if (otp_lock_held_by_caller()) {
+        return SAFEROTP_LOCK_STATUS_ALREADY_HELD;
+    }
+    // timeout_us == 0 makes a single attempt
+    bool acquired = recursive_mutex_try_enter(&g_otp_rmw_mutex, NULL);
+    if (!acquired && timeout_us != 0u) {
+        uint64_t deadline = time_us_64() + timeout_us;
+        uint32_t backoff_us = 1u;
+        while (!acquired && otp_backoff_until(deadline, backoff_us)) {
+            acquired = recursive_mutex_try_enter(&g_otp_rmw_mutex, NULL);
+            backoff_us = otp_next_backoff_us(backoff_us);
+        }
+    }
+    if (!acquired) {
+        return SAFEROTP_LOCK_STATUS_BUSY;
+    }
+    // Only the holder reads or writes these, until it releases the mutex
+    g_otp_lock_timeout_us = timeout_us;
+    g_otp_lock_last_status = SAFEROTP_LOCK_STATUS_OK;
+    __atomic_store_n(&g_otp_lock_owner, lock_get_caller_owner_id(), __ATOMIC_RELAXED);
+    return SAFEROTP_LOCK_STATUS_OK;
+}
+static uint8_t otp_lock_last_status(void) {
+    if (!otp_lock_held_by_caller()) {
+        PRINT_ERROR("OTP LOCK Error: last status queried, but the lock is not held by the caller\n");
+        return SAFEROTP_LOCK_STATUS_NOT_HELD;
+    }
+    return g_otp_lock_last_status;
+}
+static bool otp_lock_release(void) {
+    if (!otp_lock_held_by_caller()) {
+        PRINT_ERROR("OTP LOCK Error: lock released, but not held by the caller\n");
+        return false;
+    }
+    __atomic_store_n(&g_otp_lock_owner, LOCK_INVALID_OWNER_ID, __ATOMIC_RELAXED);
+    recursive_mutex_exit(&g_otp_rmw_mutex);
+    return true;
+}
+// All bootrom OTP access goes through here.  The SDK wrapper takes BOOTLOCK2 around the call
+// (if built with bootrom locking), so BOOTROM_ERROR_LOCK_REQUIRED only means another user
+// held it at the time.  The bootrom rejects the call before accessing the OTP, so it is retried.
+// The holder of saferotp_lock_acquire() retries only within its own `timeout_us`.
+static int otp_access_bootrom(void* buffer, size_t buffer_size, otp_cmd_t cmd) {
+    int r = rom_func_otp_access((uint8_t*)buffer, buffer_size, cmd);
+    if (r != BOOTROM_ERROR_LOCK_REQUIRED) {
+        return r;
+    }
+    bool lock_holder = otp_lock_held_by_caller();
+    uint32_t retry_us = lock_holder ? g_otp_lock_timeout_us : xBOOTROM_LOCK_RETRY_US;
+    uint64_t deadline = time_us_64() + retry_us;
+    uint32_t backoff_us = 1u;
+    while (r == BOOTROM_ERROR_LOCK_REQUIRED && otp_backoff_until(deadline, backoff_us)) {
+        r = rom_func_otp_access((uint8_t*)buffer, buffer_size, cmd);
+        backoff_us = otp_next_backoff_us(backoff_us);
+    }
+    if (r == BOOTROM_ERROR_LOCK_REQUIRED) {
+        PRINT_ERROR("OTP_RW Error: BOOTLOCK2 still held elsewhere after %" PRIu32 "us\n", retry_us);
+        if (lock_holder) {
+            g_otp_lock_last_status = SAFEROTP_LOCK_STATUS_BUSY;
+        }
+    }
+    return r;
+}
+// Writers (RMW mutex held): bracket every change to OTP rows.
+// For virtualized OTP, also disable interrupts between begin and end.
+static void write_seq_begin(void) {
+    __atomic_store_n(&g_otp_write_seq, g_otp_write_seq + 1u, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+}
+static void write_seq_end(void) {
+    __atomic_store_n(&g_otp_write_seq, g_otp_write_seq + 1u, __ATOMIC_RELEASE);
+}
+// Readers: start of a read that must not overlap a write (waits only for an in-progress write)
+static uint32_t read_seq_begin(void) {
+    uint32_t seq;
+    while (((seq = __atomic_load_n(&g_otp_write_seq, __ATOMIC_ACQUIRE)) & 1u) != 0u) {
+        tight_loop_contents();
+    }
+    return seq;
+}
+// Readers: true if a write started since read_seq_begin(), so the read must be retried
+static bool read_seq_retry(uint32_t seq) {
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    return __atomic_load_n(&g_otp_write_seq, __ATOMIC_RELAXED) != seq;
+}
+
 // returns TRUE on successful write, FALSE on failures
 static bool hw_write_raw_otp_wrapper(uint16_t starting_row, const void* buffer, size_t buffer_size) {
-    // NOTE: rom_func_otp_access() ensures necessary bootrom locks are acquired.
+    // NOTE: the SDK's rom_func_otp_access() wrapper takes BOOTLOCK2 for each call.
     //       Memory-mapped regions are *NOT* protected from simultaneous access, and
     //       the documentation explicitly warns that the (opaque) Synopsys OTP IP block
     //       requires serializing all access to the OTP.
@@ -67,19 +248,101 @@ static bool hw_write_raw_otp_wrapper(uint16_t starting_row, const void* buffer,
     cmd.flags |= OTP_CMD_WRITE_BITS;
     PRINT_DEBUG("OTP WRITE Debug: about to write OTP starting at row %03x %d bytes (0x%x rows\n", starting_row, buffer_size, (buffer_size/sizeof(uint32_t)));
     WAIT_FOR_KEY();
-    int r = rom_func_otp_access((uint8_t*)buffer, buffer_size, cmd);
+    int r = otp_access_bootrom((void*)buffer, buffer_size, cmd);
     if (r != BOOTROM_OK) {
         PRINT_ERROR("OTP WRITE Error: Failed to write raw OTP values starting at row %03x (%d bytes / 0x%x rows), error %d (0x%x)\n", starting_row, buffer_size, (buffer_size/sizeof(uint32_t)), r, r);
     }
     return (BOOTROM_OK == r);
 }
+// Secure read permission of each OTP page, for the memory-mapped backend and the raw row cache.
+// SAFEROTP_SW_LOCK_BASE may be defined to point at a plain array (one uint32_t per page),
+// to test this code on a host.
+#ifndef SAFEROTP_MMAP_RAW_READS
+    #define SAFEROTP_MMAP_RAW_READS 0
+#endif
+#ifndef SAFEROTP_RAW_ROW_CACHE_BLOCKS
+    #define SAFEROTP_RAW_ROW_CACHE_BLOCKS 0
+#endif
+#if SAFEROTP_MMAP_RAW_READS || (SAFEROTP_RAW_ROW_CACHE_BLOCKS > 0)
+#ifndef SAFEROTP_SW_LOCK_BASE
+    #include "hardware/structs/otp.h" // otp_hw
+    #define SAFEROTP_SW_LOCK_BASE ((const volatile uint32_t*)&otp_hw->sw_lock[0])
+#endif
+// SW_LOCK registers and PAGEn_LOCK1 rows (LOCK_S) encode the secure permissions the same way
+static bool secure_lock_allows_read(uint32_t lock) {
+    enum {
+        LOCK_SECURE_MASK = 0x3u, // least significant two bits are the secure mode permissions
+        LOCK_READ_ONLY   = 0x1u, // 0x0 == R/W, 0x1 == R/O, all others treated as NO ACCESS
+    };
+    return (lock & LOCK_SECURE_MASK) <= LOCK_READ_ONLY;
+}
+#endif // SAFEROTP_MMAP_RAW_READS || (SAFEROTP_RAW_ROW_CACHE_BLOCKS > 0)
+
+// Optional memory-mapped backend for raw reads.
+// Each rom_func_otp_access() call has a high fixed cost, while the (non-guarded)
+// raw memory-mapped alias of the OTP can be read at close to memcpy() speed.
+// The Synopsys OTP IP block requires all access to be serialized.  The SDK's
+// rom_func_otp_access() wrapper takes the bootrom's OTP boot lock (BOOTROM_LOCK_OTP,
+// BOOTLOCK2) for each bootrom call, and this library never holds it across calls,
+// so each memory-mapped read likewise takes it for just that read.  If that lock is
+// held elsewhere, or any page of the read is not readable (per its SW_LOCK register,
+// or its hard PAGEn_LOCK1 row), the read falls back to the bootrom, so errors are
+// reported exactly as before.
+//
+// SAFEROTP_MMAP_RAW_READS == 0 (default) disables this backend.
+// SAFEROTP_MMAP_RAW_BASE may be defined to point at a plain array (one uint32_t per row),
+// to test this code on a host.
+#if SAFEROTP_MMAP_RAW_READS
+#ifndef SAFEROTP_MMAP_RAW_BASE
+    #include "hardware/regs/addressmap.h" // OTP_DATA_RAW_BASE
+    #define SAFEROTP_MMAP_RAW_BASE ((const volatile uint32_t*)OTP_DATA_RAW_BASE)
+#endif
+// PAGEn_LOCK1 is stored at row 0xF81 + 2*n, as a byte with 3x redundancy
+#define xMMAP_PAGE_LOCK1_ROW(page) ((uint16_t)(0xF81u + (2u * (page))))
+static inline uint8_t byte_3x_vote(uint32_t raw);
+// returns TRUE on successful read, FALSE if the bootrom must be used instead
+static bool mmap_read_raw_otp(uint16_t starting_row, void* buffer, size_t buffer_size) {
+    size_t row_count = buffer_size / sizeof(uint32_t);
+    size_t first_page = starting_row / NUM_OTP_PAGE_ROWS;
+    size_t last_page = (starting_row + row_count - 1u) / NUM_OTP_PAGE_ROWS;
+    const volatile uint32_t * sw_lock = SAFEROTP_SW_LOCK_BASE;
+    for (size_t page = first_page; page <= last_page; ++page) {
+        // the PAGEn_LOCK1 row must itself be readable
+        if (!secure_lock_allows_read(sw_lock[page]) ||
+            !secure_lock_allows_read(sw_lock[xMMAP_PAGE_LOCK1_ROW(page) / NUM_OTP_PAGE_ROWS])) {
+            return false;
+        }
+    }
+    if (!bootrom_try_acquire_lock(BOOTROM_LOCK_OTP)) {
+        return false;
+    }
+    const volatile uint32_t * raw = SAFEROTP_MMAP_RAW_BASE;
+    bool readable = true;
+    for (size_t page = first_page; readable && page <= last_page; ++page) {
+        readable = secure_lock_allows_read(byte_3x_vote(raw[xMMAP_PAGE_LOCK1_ROW(page)]));
+    }
+    if (readable) {
+        const volatile uint32_t * src = &raw[starting_row];
+        uint32_t * out = (uint32_t*)buffer;
+        for (size_t i = 0; i < row_count; ++i) {
+            out[i] = src[i];
+        }
+    }
+    bootrom_release_lock(BOOTROM_LOCK_OTP);
+    return readable;
+}
+#endif // SAFEROTP_MMAP_RAW_READS
+
 // returns TRUE on successful read, FALSE on failures
 static bool hw_read_raw_otp_wrapper(uint16_t starting_row, void* buffer, size_t buffer_size) {
-    // TODO: Check BOOTLOCK7 to determine if bootrom will require ownership of BOOTLOCK2 (OTP)
-    //       This would return error BOOTROM_ERROR_LOCK_REQUIRED (-19) if this ever occurs.
+#if SAFEROTP_MMAP_RAW_READS
+    if (mmap_read_raw_otp(starting_row, buffer, buffer_size)) {
+        return true;
+    }
+#endif
     otp_cmd_t cmd;
     cmd.flags = starting_row;
-    int r = rom_func_otp_access((uint8_t*)buffer, buffer_size, cmd);
+    int r = otp_access_bootrom(buffer, buffer_size, cmd);
     PRINT_DEBUG("OTP READ Debug: about to write OTP starting at row %03x %d bytes (0x%x rows\n", starting_row, buffer_size, (buffer_size/sizeof(uint32_t)));
     if (r != BOOTROM_OK) {
         PRINT_ERROR("OTP READ Error: Failed to write raw OTP values starting at row %03x (%d bytes / 0x%x rows), error %d (0x%x)\n", starting_row, buffer_size, (buffer_size/sizeof(uint32_t)), r, r);
@@ -87,6 +350,163 @@ static bool hw_read_raw_otp_wrapper(uint16_t starting_row, void* buffer, size_t
     return (BOOTROM_OK == r);
 }
 
+// Optional read-through cache of raw OTP rows, below every encoding.
+// Each bootrom call has a high fixed cost, and the same rows are often read
+// again shortly after (e.g., each ECC write reads its row before and after writing,
+// and directory iteration re-reads the same entries on each search).
+//
+// The cache is direct-mapped, in blocks of 16 rows, each with a valid bit per row.
+// Only rows that were successfully read are cached, so rows that fail to read are
+// retried (and reported) on every read.  A read that misses fills every block it
+// touches with a single bootrom call.  Every write through write_raw_wrapper()
+// invalidates the written rows (whether or not the write succeeded), so that
+// verification after a write always reads the OTP itself.  A fill is discarded
+// if a write started after its bootrom read, so stale rows are never cached.
+// The cache is only accessed with the (short, interrupts disabled) cache spin lock held.
+// Call saferotp_flush_raw_row_cache() if the OTP may have changed by other means.
+//
+// Rows are only served from the cache while the SW_LOCK register of each page read
+// still allows secure reads, so locking a page takes effect at once.  Hard page locks
+// (PAGEn_LOCK1 rows) only take effect at reset, when the cache is empty.  Reads of
+// a page that is not readable go to the bootrom, which reports the error.
+//
+// SAFEROTP_RAW_ROW_CACHE_BLOCKS == 0 (default) disables the cache.
+// Each block uses 68 bytes of RAM (e.g., 16 blocks == 256 rows == ~1k).
+#if SAFEROTP_RAW_ROW_CACHE_BLOCKS > 0
+#define xCACHE_ROWS_PER_BLOCK (16u)
+static_assert(NUM_OTP_PAGE_ROWS % xCACHE_ROWS_PER_BLOCK == 0u, "blocks must not cross OTP pages");
+// Short critical sections only: interrupts are disabled while the cache lock is held
+static uint32_t otp_cache_lock(void) {
+    otp_locks_init();
+    return spin_lock_blocking(g_otp_cache_lock);
+}
+static void otp_cache_unlock(uint32_t saved_irq) {
+    spin_unlock(g_otp_cache_lock, saved_irq);
+}
+// True if the SW_LOCK register of every page of the rows allows secure reads
+static bool sw_lock_allows_read(uint16_t starting_row, size_t row_count) {
+    const volatile uint32_t * sw_lock = SAFEROTP_SW_LOCK_BASE;
+    size_t last_page = (starting_row + row_count - 1u) / NUM_OTP_PAGE_ROWS;
+    for (size_t page = starting_row / NUM_OTP_PAGE_ROWS; page <= last_page; ++page) {
+        if (!secure_lock_allows_read(sw_lock[page])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+typedef struct _RAW_ROW_CACHE_BLOCK {
+    uint16_t block;      // OTP row / xCACHE_ROWS_PER_BLOCK
+    uint16_t valid_rows; // bit `i` set if `rows[i]` holds the value read from that row
+    uint32_t rows[xCACHE_ROWS_PER_BLOCK];
+} RAW_ROW_CACHE_BLOCK;
+static RAW_ROW_CACHE_BLOCK g_raw_row_cache[SAFEROTP_RAW_ROW_CACHE_BLOCKS];
+
+static RAW_ROW_CACHE_BLOCK* cache_block_for_row(uint16_t row) {
+    return &g_raw_row_cache[(row / xCACHE_ROWS_PER_BLOCK) % SAFEROTP_RAW_ROW_CACHE_BLOCKS];
+}
+static bool cache_lookup(uint16_t row, uint32_t* out_data) {
+    RAW_ROW_CACHE_BLOCK * c = cache_block_for_row(row);
+    uint16_t bit = 1u << (row % xCACHE_ROWS_PER_BLOCK);
+    if ((c->block != (row / xCACHE_ROWS_PER_BLOCK)) || ((c->valid_rows & bit) == 0u)) {
+        return false;
+    }
+    *out_data = c->rows[row % xCACHE_ROWS_PER_BLOCK];
+    return true;
+}
+static void cache_store(uint16_t starting_row, const uint32_t* data, size_t row_count) {
+    for (size_t i = 0; i < row_count; ++i) {
+        uint16_t row = starting_row + i;
+        RAW_ROW_CACHE_BLOCK * c = cache_block_for_row(row);
+        if (c->block != (row / xCACHE_ROWS_PER_BLOCK)) {
+            c->block = row / xCACHE_ROWS_PER_BLOCK; // evict the previous block
+            c->valid_rows = 0u;
+        }
+        c->rows[row % xCACHE_ROWS_PER_BLOCK] = data[i];
+        c->valid_rows |= (uint16_t)(1u << (row % xCACHE_ROWS_PER_BLOCK));
+    }
+}
+// Stores rows read by the bootrom, unless a write started since `seq` (from before the read)
+static void cache_store_if_unchanged(uint32_t seq, uint16_t starting_row, const uint32_t* data, size_t row_count) {
+    uint32_t saved_irq = otp_cache_lock();
+    if (((seq & 1u) == 0u) && !read_seq_retry(seq)) {
+        cache_store(starting_row, data, row_count);
+    }
+    otp_cache_unlock(saved_irq);
+}
+static void cache_invalidate(uint16_t starting_row, size_t row_count) {
+    uint32_t saved_irq = otp_cache_lock();
+    for (size_t i = 0; i < row_count; ++i) {
+        uint16_t row = starting_row + i;
+        RAW_ROW_CACHE_BLOCK * c = cache_block_for_row(row);
+        if (c->block == (row / xCACHE_ROWS_PER_BLOCK)) {
+            c->valid_rows &= (uint16_t)~(1u << (row % xCACHE_ROWS_PER_BLOCK));
+        }
+    }
+    otp_cache_unlock(saved_irq);
+}
+static void cache_flush(void) {
+    uint32_t saved_irq = otp_cache_lock();
+    for (size_t i = 0; i < SAFEROTP_RAW_ROW_CACHE_BLOCKS; ++i) {
+        g_raw_row_cache[i].valid_rows = 0u;
+    }
+    otp_cache_unlock(saved_irq);
+}
+// Same results as hw_read_raw_otp_wrapper(), but served from the cache when every row is cached.
+static bool cached_hw_read_raw_otp_wrapper(uint16_t starting_row, void* buffer, size_t buffer_size) {
+    uint32_t * out = (uint32_t*)buffer;
+    size_t row_count = buffer_size / sizeof(uint32_t);
+
+    // 0. Never serve (or fill) cached rows of a page that software has since locked
+    if (!sw_lock_allows_read(starting_row, row_count)) {
+        return hw_read_raw_otp_wrapper(starting_row, buffer, buffer_size);
+    }
+
+    // 1. Every row already cached?
+    size_t hits = 0u;
+    uint32_t saved_irq = otp_cache_lock();
+    while ((hits < row_count) && cache_lookup(starting_row + hits, &out[hits])) {
+        ++hits;
+    }
+    otp_cache_unlock(saved_irq);
+    if (hits == row_count) {
+        return true;
+    }
+    uint32_t seq = __atomic_load_n(&g_otp_write_seq, __ATOMIC_ACQUIRE);
+
+    // 2. Fill all the blocks touched by the read, with a single bootrom call (if at most a page of rows)
+    uint16_t fill_start = starting_row - (starting_row % xCACHE_ROWS_PER_BLOCK);
+    size_t fill_end = starting_row + row_count;
+    fill_end += (xCACHE_ROWS_PER_BLOCK - (fill_end % xCACHE_ROWS_PER_BLOCK)) % xCACHE_ROWS_PER_BLOCK;
+    if ((fill_end - fill_start) <= NUM_OTP_PAGE_ROWS) {
+        uint32_t fill[NUM_OTP_PAGE_ROWS];
+        if (hw_read_raw_otp_wrapper(fill_start, fill, (fill_end - fill_start) * sizeof(uint32_t))) {
+            cache_store_if_unchanged(seq, fill_start, fill, fill_end - fill_start);
+            memcpy(out, &fill[starting_row - fill_start], buffer_size);
+            return true;
+        }
+        // some row of the blocks failed to read ... fall through to read only the requested rows
+    }
+
+    // 3. Read only the requested rows
+    if (!hw_read_raw_otp_wrapper(starting_row, buffer, buffer_size)) {
+        return false;
+    }
+    cache_store_if_unchanged(seq, starting_row, out, row_count);
+    return true;
+}
+#else
+static void cache_invalidate(uint16_t starting_row, size_t row_count) {
+    (void)starting_row;
+    (void)row_count;
+}
+static void cache_flush(void) {
+}
+static bool cached_hw_read_raw_otp_wrapper(uint16_t starting_row, void* buffer, size_t buffer_size) {
+    return hw_read_raw_otp_wrapper(starting_row, buffer, buffer_size);
+}
+#endif // SAFEROTP_RAW_ROW_CACHE_BLOCKS > 0
+
 // Enable "virtualized" OTP ... useful for testing.
 // 16k of OTP is a lot to virtualize... 
 // but RP2350 has 512k, of which >256k is currently free, so go with SIMPLE!
@@ -196,7 +616,13 @@ static bool virt_override_restore(uint16_t starting_row, const void* buffer, siz
     }
     // NOTE: This simply replaces the values, even if doing so would not otherwise have been a valid write.
     //       Allows resetting pages to zero (bits from 1 -> 0), bypasses permissions, etc.
+    otp_rmw_lock();
+    uint32_t saved_irq = save_and_disable_interrupts();
+    write_seq_begin();
     memcpy(&g_virtual_otp.rows[starting_row], buffer, buffer_size);
+    write_seq_end();
+    restore_interrupts(saved_irq);
+    otp_rmw_unlock();
     return true;
 }
 static bool virt_override_save(uint16_t starting_row, void* buffer, size_t buffer_size) {
@@ -205,7 +631,11 @@ static bool virt_override_save(uint16_t starting_row, void* buffer, size_t buffe
         PRINT_ERROR("OTP VIRT Error: Invalid (start row / raw byte count): 0x%03x %zu\n", starting_row, buffer_size);
         return false;
     }
-    memcpy(buffer, &g_virtual_otp.rows[starting_row], buffer_size);
+    uint32_t seq;
+    do {
+        seq = read_seq_begin();
+        memcpy(buffer, &g_virtual_otp.rows[starting_row], buffer_size);
+    } while (read_seq_retry(seq));
     return true;
 }
 
@@ -219,7 +649,7 @@ static bool virt_write_raw_otp_wrapper(uint16_t starting_row, const void* buffer
         PRINT_ERROR("OTP VIRT WRITE Error: Invalid (start row / raw byte count): 0x%03x %zu\n", starting_row, buffer_size);
         return false;
     }
-    // TODO: Check BOOTLOCK7 to determine if bootrom will require ownership of BOOTLOCK2 (OTP)
+    // NOTE: Virtualized OTP never calls the bootrom, so BOOTLOCK2 is not required.
     size_t row_count = buffer_size / sizeof(uint32_t);
     // process each row in order (per RP2350 datasheet ... )
     for (size_t i = 0; i < row_count; ++i) {
@@ -242,8 +672,8 @@ static bool virt_write_raw_otp_wrapper(uint16_t starting_row, const void* buffer
             );
             return false;
         }
-        // Update the individual row's data
-        current->as_uint32 = new_value->as_uint32;
+        // Update the individual row's data (OR, as the fuses would)
+        __atomic_fetch_or(&current->as_uint32, new_value->as_uint32, __ATOMIC_RELAXED);
     }
     return true;
 }
@@ -258,21 +688,26 @@ static bool virt_read_raw_otp_wrapper(uint16_t starting_row, void* buffer, size_
         PRINT_ERROR("OTP VIRT READ Error: Invalid (start row / raw byte count): 0x%03x %zu\n", starting_row, buffer_size);
         return false;
     }
-    // TODO: Check BOOTLOCK7 to determine if bootrom will require ownership of BOOTLOCK2 (OTP)
+    // NOTE: Virtualized OTP never calls the bootrom, so BOOTLOCK2 is not required.
     size_t row_count = buffer_size / sizeof(uint32_t);
+    uint32_t * out = (uint32_t*)buffer;
+    // Lock-free copy of the rows, retried if a write changed rows during the copy
+    uint32_t seq;
+    do {
+        seq = read_seq_begin();
+        for (size_t i = 0; i < row_count; ++i) {
+            out[i] = __atomic_load_n(&g_virtual_otp.rows[starting_row + i].as_uint32, __ATOMIC_RELAXED);
+        }
+    } while (read_seq_retry(seq));
     // process each row in order (per RP2350 datasheet ... )
     for (size_t i = 0; i < row_count; ++i) {
         // TODO: Any permissions checks, when implemented....
 
         // verify the existing value was readable ... else return an error
-        SAFEROTP_RAW_READ_RESULT *current = &g_virtual_otp.rows[starting_row + i];
-        if (current->is_error) {
+        if ((out[i] & 0xFF000000u) != 0u) {
             PRINT_ERROR("OTP VIRT READ Error: Attempt to write virtualized OTP row 0x%03x, which previously failed to read (start row %03x, buffer size %zx)\n", starting_row+i, starting_row, buffer_size);
             return false; // report the error
         }
-        // Else return the value from the virtualized buffer
-        uint32_t * to_write = &(((uint32_t*)buffer)[i]);
-        *to_write = current->as_uint32;
     }
     return true;
 }
@@ -285,13 +720,25 @@ static bool write_raw_wrapper(uint16_t starting_row, const void* buffer, size_t
         PRINT_ERROR("OTP WRITE Error: Invalid (start row / raw byte count): 0x%03x %zu\n", starting_row, buffer_size);
         return false;
     }
+    // Caller holds the RMW mutex
+    bool result;
     if (g_virtual_otp_initialized) {
-        return virt_write_raw_otp_wrapper(starting_row, buffer, buffer_size);
+        // short memory update: virtualized OTP readers on this core must never see an odd count
+        uint32_t saved_irq = save_and_disable_interrupts();
+        write_seq_begin();
+        result = virt_write_raw_otp_wrapper(starting_row, buffer, buffer_size);
+        write_seq_end();
+        restore_interrupts(saved_irq);
     } else {
-        return hw_write_raw_otp_wrapper(starting_row, buffer, buffer_size);
+        // slow fuse programming, with interrupts enabled: only the cache uses the count, and never waits on it
+        write_seq_begin();
+        result = hw_write_raw_otp_wrapper(starting_row, buffer, buffer_size);
+        cache_invalidate(starting_row, buffer_size / sizeof(uint32_t)); // even on failure, rows may have changed
+        write_seq_end();
     }
+    return result;
 }
-static bool read_raw_wrapper(uint16_t starting_row, void* buffer, size_t buffer_size) {
+static bool is_valid_raw_read(uint16_t starting_row, size_t buffer_size) {
     if (!is_valid_otp_range_raw(starting_row, buffer_size)) {
         PRINT_ERROR("OTP WRITE Error: Invalid (start row / raw byte count): 0x%03x %zu\n", starting_row, buffer_size);
         return false;
@@ -300,12 +747,65 @@ static bool read_raw_wrapper(uint16_t starting_row, void* buffer, size_t buffer_
         PRINT_ERROR("OTP VIRT Error: Attempt to read virtualized OTP data with non-aligned size %d\n", buffer_size);
         return false;
     }
+    return true;
+}
+static bool read_raw_wrapper(uint16_t starting_row, void* buffer, size_t buffer_size) {
+    if (!is_valid_raw_read(starting_row, buffer_size)) {
+        return false;
+    }
+    if (g_virtual_otp_initialized) {
+        return virt_read_raw_otp_wrapper(starting_row, buffer, buffer_size);
+    } else {
+        return cached_hw_read_raw_otp_wrapper(starting_row, buffer, buffer_size);
+    }
+}
+// Same as read_raw_wrapper(), but never reads from (or fills) the raw row cache.
+// For secrets: the rows are not left in the cache, and the read time does not
+// depend on what was cached.
+static bool read_raw_uncached_wrapper(uint16_t starting_row, void* buffer, size_t buffer_size) {
+    if (!is_valid_raw_read(starting_row, buffer_size)) {
+        return false;
+    }
     if (g_virtual_otp_initialized) {
         return virt_read_raw_otp_wrapper(starting_row, buffer, buffer_size);
     } else {
         return hw_read_raw_otp_wrapper(starting_row, buffer, buffer_size);
     }
 }
+// Clears a buffer that held secrets.  The volatile stores cannot be removed by the
+// compiler, even when the buffer is not read again.
+static void wipe_secret(void* buffer, size_t buffer_size) {
+    volatile uint8_t * p = (volatile uint8_t*)buffer;
+    for (size_t i = 0; i < buffer_size; ++i) {
+        p[i] = 0u;
+    }
+}
+// Reads many raw rows using as few bootrom calls as possible.
+// If a chunk fails to read, each row of that chunk is retried individually,
+// so a single bad row does not prevent reading the other rows.
+// Rows that still fail to read are set to 0xFFFFFFFFu (always an error value).
+// Returns false if any row failed to read.
+static bool read_raw_rows_with_fallback(uint16_t start_row, uint32_t* out_raw, size_t row_count) {
+    enum { ROWS_PER_CHUNK = NUM_OTP_PAGE_ROWS };
+    bool all_rows_read = true;
+    for (size_t i = 0; i < row_count; i += ROWS_PER_CHUNK) {
+        size_t chunk_rows = row_count - i;
+        if (chunk_rows > ROWS_PER_CHUNK) {
+            chunk_rows = ROWS_PER_CHUNK;
+        }
+        if (read_raw_wrapper(start_row + i, &out_raw[i], chunk_rows * sizeof(uint32_t))) {
+            continue;
+        }
+        for (size_t j = i; j < i + chunk_rows; ++j) {
+            if (!read_raw_wrapper(start_row + j, &out_raw[j], sizeof(uint32_t))) {
+                PRINT_ERROR("OTP_RW Error: Failed to read OTP raw row %03x\n", start_row + j);
+                out_raw[j] = 0xFFFFFFFFu;
+                all_rows_read = false;
+            }
+        }
+    }
+    return all_rows_read;
+}
 // RP2350 OTP storage is strongly recommended to use some form of
 // error correction.  Most rows will use ECC, but three other forms exist:
 // (1) 2-of-3 voting of a single byte in a single row
@@ -347,76 +847,30 @@ static bool write_single_otp_ecc_row(uint16_t row, uint16_t data) {
         return false;
     }
 
-    // 2. SUCCESS if existing raw data already encodes the value; Do not update the OTP row.
-    //    TODO: Consider if existing data has a single bit flipped from one to zero ... could write
-    //          the extra bit to try to reduce errors?
-    uint32_t decode_result = saferotp_decode_raw(existing_raw_data);
-    if (((decode_result & 0xFF000000u) == 0u) && ((uint16_t)decode_result == data)) {
+    // 2. Plan the write: SUCCESS without writing if the existing raw data already encodes the value,
+    //    else adjust the encoded data for bits already set (e.g., BRBP), or fail if not possible.
+    SAFEROTP_ECC_WRITE_PLAN plan;
+    saferotp_plan_ecc_writes(&existing_raw_data, &data, &plan, 1u);
+    if (plan.action == SAFEROTP_ECC_WRITE_PLAN_NO_WRITE) {
         // already written, nothing more to do for this row
         PRINT_VERBOSE("OTP_RW: Row %03x already has data 0x%04x .. not writing\n", row, data);
         return true;
+    } else if (plan.action == SAFEROTP_ECC_WRITE_PLAN_IMPOSSIBLE) {
+        // No way to write the encoded ECC data (even if using BRBP)
+        PRINT_ERROR("OTP_RW Error: Cannot write ECC OTP row %03x with data 0x%04x (ECC encoding 0x%06x, existing 0x%06x)\n",
+            row, data, saferotp_calculate_ecc(data), existing_raw_data
+        );
+        return false;
+    } else if (plan.action == SAFEROTP_ECC_WRITE_PLAN_WRITE_DEGRADED) {
+        // OPTION: Consider allowing callers to REJECT writes with even a single-bit error?
+        // The value will still be properly decoded.
+        PRINT_WARNING("OTP_RW WARN: Writing ECC OTP row %03x with data 0x%06x: Redundancy compromised, but writing %s is possible (existing 0x%06x).\n",
+            row, plan.raw_to_write, plan.inverted ? "as BRBP" : "", existing_raw_data
+        );
     }
+    uint32_t data_to_write = plan.raw_to_write;
 
-    // 3. Do we have to adjust the encoded data due to existing BRBP bits?  Determine data to write (or fail if not possible)
-    uint32_t data_to_write;
-    do {
-        enum {
-            MASK_BRBP_BITS     = 0xC00000u,
-            MASK_NON_BRBP_BITS = 0x3FFFFFu,
-            MASK_ALL_RAW_BITS  = 0xFFFFFFu,
-        };
-
-        uint32_t encoded_new_data = saferotp_calculate_ecc(data);
-        uint32_t encoded_new_data_brbp = encoded_new_data ^ MASK_ALL_RAW_BITS;
-
-        // 1. bits can only transition from 0 --> 1
-        uint32_t to_write      = existing_raw_data | encoded_new_data;
-        uint32_t to_write_brbp = existing_raw_data | encoded_new_data_brbp;
-
-        // 2. bits that differ from new_data represent errors
-        uint32_t error_bits      = encoded_new_data      ^ to_write;
-        uint32_t error_bits_brbp = encoded_new_data_brbp ^ to_write_brbp;
-
-        // 3. One or fewer errors for non-brbp?  If so, that's good enough.
-        if (__builtin_popcount(error_bits) == 0u) {
-            // Great!  Can write without adjusting for existing data.
-            data_to_write = to_write;
-        } else if (__builtin_popcount(error_bits_brbp) == 0u) {
-            // Great!  Can write without adjusting for existing data.
-            data_to_write = to_write_brbp;
-        } else if (
-            (__builtin_popcount(error_bits_brbp & MASK_BRBP_BITS    ) <= 1u) &&
-            (__builtin_popcount(error_bits_brbp & MASK_NON_BRBP_BITS) <= 1u)
-        ) {
-            // OPTION: Consider allowing callers to REJECT writes with even a single-bit error?
-            // BRBP can have a single-bit error, and the remaining bits can also have a single-bit error.
-            // The value will still be properly decoded.
-            PRINT_WARNING("OTP_RW WARN: Writing ECC OTP row %03x with data 0x%06x: Redundancy compromised, but writing as BRBP is possible (bit errors: %06x).\n",
-                row, encoded_new_data_brbp, error_bits_brbp
-            );  
-            data_to_write = to_write_brbp;
-        } else if (
-            (__builtin_popcount(error_bits & MASK_BRBP_BITS    ) <= 1u) &&
-            (__builtin_popcount(error_bits & MASK_NON_BRBP_BITS) <= 1u)
-        ) {
-            // OPTION: Consider allowing callers to REJECT writes with even a single-bit error?
-            // BRBP can have a single-bit error, and the remaining bits can also have a single-bit error.
-            // The value will still be properly decoded.
-            // TODO: Verify the bootrom will also allow non-BRBP data to have a single-bit error in the BRBP bits?
-            PRINT_WARNING("OTP_RW WARN: Writing ECC OTP row %03x with data 0x%06x: Redundancy compromised, but writing as BRBP is possible (bit errors: %06x).\n",
-                row, encoded_new_data, error_bits
-            );  
-            data_to_write = to_write;
-        } else {
-            // No way to write the encoded ECC data (even if using BRBP)
-            PRINT_ERROR("OTP_RW Error: Cannot write ECC OTP row %03x with data 0x%06x / 0x%06x (existing 0x%06x): bit errors %06x / %06x\n",
-                row, encoded_new_data, encoded_new_data_brbp, existing_raw_data, error_bits, error_bits_brbp
-            );
-            return false;
-        }
-    } while (0);
-
-    // 4. write the encoded raw data
+    // 3. write the encoded raw data
     if (!write_raw_wrapper(row, &data_to_write, sizeof(data_to_write))) {
         PRINT_ERROR("OTP_RW Error: Failed to write ECC OTP row %03x with data 0x%06x (ECC encoding of 0x%04x)\n",
             row, data_to_write, data
@@ -424,14 +878,14 @@ static bool write_single_otp_ecc_row(uint16_t row, uint16_t data) {
         return false;
     }
 
-    // 5. And finally, verify the expected data is now readable from that OTP row
+    // 4. And finally, verify the expected data is now readable from that OTP row
     uint16_t verify_data;
-    if (!read_single_otp_ecc_row(row, &verify_data)) {
+    if (!read_single_otp_ecc_row(row, &verify_data) || (verify_data != data)) {
         PRINT_ERROR("OTP_RW Error: Failed to verify ECC OTP row %03x has data 0x%04x\n", row, data);
         return false;
     }
 
-    // 6. New data was written and verified.  Success!
+    // 5. New data was written and verified.  Success!
     return true;
 }
 static bool write_single_otp_raw_row(uint16_t row, uint32_t data) {
@@ -472,62 +926,88 @@ static bool write_single_otp_raw_row(uint16_t row, uint32_t data) {
     }
     return true;
 }
-static bool read_single_otp_value_N_of_M(uint16_t start_row, uint8_t N, uint8_t M, uint32_t* out_data) {
-    #define MAX_M_VALUE (8u)
-
-    *out_data = 0xFFFFFFFFu;
-
-    static_assert(MAX_M_VALUE < UINT8_MAX, "MAX_M_VALUE must be less than 0xFFu else need to adjust variables currently using uint8_t and uint_fast8_t");
-
-    // Support both RBIT3 and RBIT8
+#define MAX_M_VALUE (8u)
+static_assert(MAX_M_VALUE < UINT8_MAX, "MAX_M_VALUE must be less than 0xFFu else need to adjust variables currently using uint8_t and uint_fast8_t");
+static_assert(MAX_M_VALUE <= NUM_OTP_PAGE_ROWS, "each chunk must hold at least one group of M rows");
+
+// N-of-M writes only add votes until each bit set in the new value has
+// (N + SAFEROTP_N_OF_M_WRITE_MARGIN) votes, capped at the number of readable rows.
+// Every extra vote burns one more fuse, but allows that many rows to later
+// become unreadable (or lose a bit) without the value becoming ambiguous.
+// The default (MAX_M_VALUE) writes the value to every readable row.
+#ifndef SAFEROTP_N_OF_M_WRITE_MARGIN
+    #define SAFEROTP_N_OF_M_WRITE_MARGIN MAX_M_VALUE
+#endif
+static_assert(SAFEROTP_N_OF_M_WRITE_MARGIN <= MAX_M_VALUE, "SAFEROTP_N_OF_M_WRITE_MARGIN must be 0..8");
+
+static bool is_supported_N_of_M(uint8_t N, uint8_t M) {
+    // Supports RBIT3 (2-of-3), RBIT8 (3-of-8), and any other N-of-M with 1 <= N <= M <= 8
     if (M > MAX_M_VALUE) {
-        PRINT_ERROR("OTP_RW Error: Read OTP N-of-M: Unsupported M=%d (max %zu)\n", M, MAX_M_VALUE);
+        PRINT_ERROR("OTP_RW Error: OTP N-of-M: Unsupported M=%d (max %zu)\n", M, MAX_M_VALUE);
         return false;
     }
-    else if (N == 2 && M == 3) { }
-    else if (N == 3 && M == 8) { }
-    else {
-        // The below code ***should*** work for any N-of-M, so long as both N and M are <= 8.
-        // However, it's not been tested, and is not used in any real-world scenario.
-        // Thus: YAGNI ... and if you do need it, you'll need to test it yourself.
-        PRINT_ERROR("OTP_RW Error: Read OTP N-of-M: Unsupported N=%d, M=%d\n", N, M);
+    if ((N == 0u) || (N > M)) {
+        PRINT_ERROR("OTP_RW Error: OTP N-of-M: Unsupported N=%d, M=%d\n", N, M);
         return false;
     }
-
-    // NOTE: could process the read values as they come in, but keeping them in an array
-    //       greatly simplifies debugging (and thus testing and initial development).)
-    uint32_t v[MAX_M_VALUE] = {0u};    // zero-initialize the array, sized for maximum supported `M`
-    bool     r[MAX_M_VALUE] = {false}; // zero-initialized is false
-    uint_fast8_t votes[24]; // one count for each potential bit to be set
-    uint_fast8_t successful_reads = 0u;
-    uint_fast8_t failed_reads = 0u;
-
-    // Read each of the `M` rows
-    // tracking total count of successful / failed reads
-    for (size_t i = 0; i < M; ++i) {
-        bool tmp = read_raw_wrapper(start_row+i, &(v[i]), sizeof(uint32_t));
-        r[i] = tmp;
-        if (tmp) {
-            ++successful_reads;
+    return true;
+}
+// Bit-sliced vote counter: bit `j` of the count for each bit position is stored in
+// bit-plane `count[j]`, so all 24 bit positions are counted with whole-word logic.
+// Four planes count up to 15 votes, enough for MAX_M_VALUE.
+static_assert(MAX_M_VALUE <= 15u, "vote counter has four bit-planes");
+typedef struct _VOTE_COUNTER {
+    uint32_t count[4];
+} VOTE_COUNTER;
+// Adds one vote for each set bit of `w` (ripple carry-save half-adders)
+static inline void vote_counter_add(VOTE_COUNTER* c, uint32_t w) {
+    for (uint_fast8_t j = 0u; j < 4u; ++j) {
+        uint32_t carry = c->count[j] & w;
+        c->count[j] ^= w;
+        w = carry;
+    }
+}
+// Mask of bit positions with at least `k` votes (k is not data, so branching on it is fine)
+static inline uint32_t vote_counter_at_least(const VOTE_COUNTER* c, uint_fast8_t k) {
+    uint32_t greater = 0u;
+    uint32_t equal   = 0xFFFFFFFFu;
+    for (uint_fast8_t j = 4u; j-- > 0u; ) {
+        if ((k >> j) & 1u) {
+            equal   &= c->count[j];
         } else {
-            ++failed_reads;
+            greater |= equal & c->count[j];
+            equal   &= ~c->count[j];
         }
     }
+    return greater | equal;
+}
+static inline uint_fast8_t vote_counter_get(const VOTE_COUNTER* c, uint_fast8_t bit) {
+    uint_fast8_t result = 0u;
+    for (uint_fast8_t j = 0u; j < 4u; ++j) {
+        result |= ((c->count[j] >> bit) & 1u) << j;
+    }
+    return result;
+}
+// Applies N-of-M voting to the M raw values of one group of rows.
+// Rows that failed to read have a non-zero top byte (see read_raw_rows_with_fallback()).
+static bool vote_N_of_M(uint16_t start_row, uint8_t N, uint8_t M, const uint32_t* v, uint32_t* out_data) {
+    (void)start_row; // only used in debug output, which may be disabled
+    enum { MASK_DATA_BITS = 0x00FFFFFFu };
+    *out_data = 0xFFFFFFFFu;
+
+    VOTE_COUNTER votes = { .count = {0u} };
+    uint_fast8_t successful_reads = 0u;
+    uint_fast8_t failed_reads = 0u;
 
     // Calculate the votes from the reads that succeeded
     for (size_t i = 0; i < M; ++i) {
         // don't count any votes from failed reads
-        if (!r[i]) {
+        if ((v[i] & 0xFF000000u) != 0u) {
+            ++failed_reads;
             continue;
         }
-        // loop through each bit, and add a vote if that bit is set
-        uint32_t tmp = v[i];
-        for (uint_fast8_t j = 0; j < 24u; ++j) {
-            uint32_t mask = (1u << j);
-            if ((tmp & mask) != 0u) {
-                ++votes[j];
-            }
-        }
+        ++successful_reads;
+        vote_counter_add(&votes, v[i]);
     }
 
     // Success depends on BOTH the count of successful reads AND
@@ -543,7 +1023,7 @@ static bool read_single_otp_value_N_of_M(uint16_t start_row, uint8_t N, uint8_t
     }
 
     // For each bit voted upon:
-    //    If the number of votes is >= M:
+    //    If the number of votes is >= N:
     //       Set the bit in the result. (SUCCESS)
     //       Failed reads are irrelevant as they cannot cause a transition back to zero.
     //    Else if the number of failed reads is >= (N - votes):
@@ -551,85 +1031,220 @@ static bool read_single_otp_value_N_of_M(uint16_t start_row, uint8_t N, uint8_t
     //    Else:
     //       The votes say zero, which is true ***even if*** all the failed reads
     //       would have added to the vote. (SUCCESS)
-    uint32_t result = 0u;
-    for (uint_fast8_t i = 0; i < 24u; ++i) {
-        if (votes[i] >= N) {
-            uint32_t mask = (1u << i);
-            result |= mask;
-        } else if (failed_reads >= (N - votes[i])) {
-            // votes from successful reads say the bit is zero, but
-            // the failed reads could change the result from 0 --> 1
-            PRINT_ERROR("OTP_RW Error: rows 0x%03x to 0x%03x: failed reads %d >= %d - %d votes ... failing\n", start_row, start_row+M-1, failed_reads, N, votes[i]);
-            return false;
-        } else {
-            // votes from successful reads say the bit is zero, and
-            // even if all failed reads voted for a `1`, the votes
-            // would still say the bit is zero.
-            // this is a success ... leave the bit as zero in the result.
-        }
+    // Here, all 24 bits are handled at once, as masks.
+    uint32_t result = vote_counter_at_least(&votes, N) & MASK_DATA_BITS;
+    uint32_t could_flip = 0u;
+    if (failed_reads >= N) {
+        could_flip = ~result & MASK_DATA_BITS;
+    } else if (failed_reads != 0u) {
+        could_flip = vote_counter_at_least(&votes, N - failed_reads) & ~result & MASK_DATA_BITS;
+    }
+    if (could_flip != 0u) {
+        // votes from successful reads say the bit is zero, but
+        // the failed reads could change the result from 0 --> 1
+        PRINT_ERROR("OTP_RW Error: rows 0x%03x to 0x%03x: bit %d: failed reads %d >= %d - %d votes ... failing\n",
+            start_row, start_row+M-1, __builtin_ctz(could_flip), failed_reads, N, vote_counter_get(&votes, __builtin_ctz(could_flip))
+        );
+        return false;
     }
     // SUCCESS -- return the voted-upon result
+    *out_data = result;
     return true;
 }
-static bool write_single_otp_value_N_of_M(uint16_t start_row, uint8_t N, uint8_t M, uint32_t new_value) {
+// Reads and votes `group_count` consecutive groups of M rows (one value per group).
+// Each span of rows is read once, a page at a time (whole groups per chunk).
+static bool read_otp_N_of_M_data(uint16_t start_row, uint8_t N, uint8_t M, uint32_t* out_values, size_t group_count) {
+    if (!is_supported_N_of_M(N, M)) {
+        return false;
+    }
+    if (!is_valid_otp_range_raw(start_row, group_count * M * sizeof(uint32_t))) {
+        PRINT_ERROR("OTP_RW Error: Invalid (start row / count) for %d-of-%d: 0x%03x %zu\n", N, M, start_row, group_count);
+        return false;
+    }
+    uint32_t raw[NUM_OTP_PAGE_ROWS];
+    size_t groups_per_chunk = NUM_OTP_PAGE_ROWS / M;
+    for (size_t chunk = 0; chunk < group_count; chunk += groups_per_chunk) {
+        size_t chunk_groups = group_count - chunk;
+        if (chunk_groups > groups_per_chunk) {
+            chunk_groups = groups_per_chunk;
+        }
+        uint16_t chunk_start_row = start_row + (chunk * M);
+        (void)read_raw_rows_with_fallback(chunk_start_row, raw, chunk_groups * M); // failed rows are handled by voting
+        for (size_t g = 0; g < chunk_groups; ++g) {
+            if (!vote_N_of_M(chunk_start_row + (g * M), N, M, &raw[g * M], &out_values[chunk + g])) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+// Determines the raw value to write to each of the M rows of one group,
+// burning only the bits needed to give each bit of `new_value` its target votes.
+// Logically ORs the requested bits into each row's old value.
+// This allows each individual row to have extra bits set, even if not set in the new value.
+// Because the N-of-M voting was successful, this will not degrade the error detection.
+// Rows that failed to read are not written (final success is based on voting the new value).
+static void plan_N_of_M_group(uint16_t group_start_row, uint8_t N, uint8_t M, uint32_t new_value, const uint32_t* old, uint32_t* out_to_write) {
+    (void)group_start_row; // only used in debug output, which may be disabled
+    VOTE_COUNTER votes = { .count = {0u} };
+    uint_fast8_t order[MAX_M_VALUE];
+    uint_fast8_t readable_rows = 0u;
+
+    // Order the readable rows by how many new bits each needs to hold the whole value,
+    // so the extra votes are concentrated in the rows closest to the new value already.
+    for (uint_fast8_t i = 0u; i < M; ++i) {
+        out_to_write[i] = old[i];
+        if ((old[i] & 0xFF000000u) != 0u) {
+            PRINT_WARNING("OTP_RW Warn: unable to read old bits for OTP %d-of-%d: row 0x%03x -- DEFERRING\n", N, M, group_start_row + i);
+            continue;
+        }
+        vote_counter_add(&votes, old[i]);
+        uint_fast8_t missing = __builtin_popcount(new_value & ~old[i]);
+        uint_fast8_t j = readable_rows++;
+        for (; (j > 0u) && (__builtin_popcount(new_value & ~old[order[j-1u]]) > missing); --j) {
+            order[j] = order[j-1u];
+        }
+        order[j] = i;
+    }
 
-    // 1. read the old data
-    PRINT_DEBUG("OTP_RW Debug: Write OTP 2-of-3: row 0x%03x\n", start_row);
+    // Give each row, in that order, every bit of the new value that still lacks votes.
+    uint_fast8_t target_votes = N + SAFEROTP_N_OF_M_WRITE_MARGIN;
+    if (target_votes > readable_rows) {
+        target_votes = readable_rows; // vote_N_of_M() succeeded, so this is still >= N
+    }
+    for (uint_fast8_t k = 0u; k < readable_rows; ++k) {
+        uint32_t needed = new_value & ~vote_counter_at_least(&votes, target_votes);
+        if (needed == 0u) {
+            break;
+        }
+        uint_fast8_t i = order[k];
+        uint32_t added = needed & ~old[i];
+        out_to_write[i] = old[i] | added;
+        vote_counter_add(&votes, added);
+    }
+}
+// Returns false if the group cannot be voted upon, or already votes a bit as set
+// that is not set in the new value (as there's no way to unset a bit).
+static bool is_N_of_M_group_writable(uint16_t group_start_row, uint8_t N, uint8_t M, uint32_t new_value, const uint32_t* old) {
     uint32_t old_voted_bits;
-    if (!read_single_otp_value_N_of_M(start_row, N, M, &old_voted_bits)) {
-        PRINT_DEBUG("OTP_RW Debug: Failed to read %d-of-%d starting at row 0x%03x\n", N, M, start_row);
+    if ((new_value & 0xFF000000u) != 0u) {
+        PRINT_ERROR("OTP_RW Error: %d-of-%d value 0x%08x for row 0x%03x has more than 24 bits\n", N, M, new_value, group_start_row);
+        return false;
+    }
+    if (!vote_N_of_M(group_start_row, N, M, old, &old_voted_bits)) {
+        PRINT_DEBUG("OTP_RW Debug: Failed to read %d-of-%d starting at row 0x%03x\n", N, M, group_start_row);
         return false;
     }
-
     // If any bits are already voted upon as set, there's no way to unset them.
     uint32_t incompatible_bits = old_voted_bits & ~new_value;
     if (incompatible_bits != 0u) {
-        PRINT_ERROR("OTP_RW Error: Fail: Old voted-upon value 0x%06x has bits set that are not in the new value 0x%06x ---> 0x%06x\n",
-            old_voted_bits, new_value, incompatible_bits
+        PRINT_ERROR("OTP_RW Error: Fail: rows 0x%03x: Old voted-upon value 0x%06x has bits set that are not in the new value 0x%06x ---> 0x%06x\n",
+            group_start_row, old_voted_bits, new_value, incompatible_bits
         );
         return false;
     }
-
-    // 2. Read-Modify-Write each row individually, logically OR'ing the requested bits into the old value.
-    //    This process allows for each individual row to have multiple bits set, even if not set in the new value.
-    //    Because the N-of-M voting was successful, this will not degrade the error detection.
-    //    Moreover, allow each individual write to fail ... final success is based on reading the new value.
-    for (uint16_t i = 0; i < M; ++i) {
-        uint32_t old_data;
-        if (!read_raw_wrapper(start_row+i, &old_data, sizeof(old_data))) {
-            PRINT_WARNING("OTP_RW Warn: unable to read old bits for OTP %d-of-%d: row 0x%03x -- DEFERRING\n", N, M, start_row+i);
-            continue; // to next OTP row, if any
+    return true;
+}
+// Reads one chunk of groups, and determines the raw value to write to each row.
+// Returns false if any group is not writable (see is_N_of_M_group_writable()).
+static bool plan_N_of_M_chunk(uint16_t start_row, uint8_t N, uint8_t M, const uint32_t* new_values, size_t group_count, uint32_t* out_old, uint32_t* out_to_write) {
+    (void)read_raw_rows_with_fallback(start_row, out_old, group_count * M);
+    for (size_t g = 0; g < group_count; ++g) {
+        uint16_t group_start_row = start_row + (g * M);
+        if (!is_N_of_M_group_writable(group_start_row, N, M, new_values[g], &out_old[g * M])) {
+            return false;
         }
-        if ((old_data & new_value) == new_value) {
-            // no change needed ... not setting any new bit for this row
-            PRINT_WARNING("OTP_RW Warn: skipping update to row 0x%03x: old value 0x%06x already has bits 0x%06x\n", start_row+i, old_data, new_value);
-            continue; // to next OTP row, if any
+        plan_N_of_M_group(group_start_row, N, M, new_values[g], &out_old[g * M], &out_to_write[g * M]);
+    }
+    return true;
+}
+// Writes one planned chunk of groups, then verifies it.  Caller holds the RMW mutex.
+static bool program_N_of_M_chunk(uint16_t chunk_start_row, uint8_t N, uint8_t M, const uint32_t* new_values, size_t chunk_groups, uint32_t* old, const uint32_t* to_write) {
+    size_t chunk_rows = chunk_groups * M;
+
+    // Write each contiguous run of rows that change
+    // Allow each write to fail ... final success is based on reading the new values.
+    size_t i = 0;
+    while (i < chunk_rows) {
+        if (to_write[i] == old[i]) {
+            ++i;
+            continue;
         }
-
-        // new_value may have additional bits set that are not intended to be set after voting.
-        // This is OK ... validate voted-upon results after the writes are all done.
-        uint32_t to_write = old_data | new_value;
-        PRINT_DEBUG("OTP_RW Debug: updating row 0x%03x: 0x%06x --> 0x%06x\n", start_row+i, old_data, to_write);
-        if (!write_raw_wrapper(start_row+i, &to_write, sizeof(to_write))){
-            PRINT_ERROR("OTP_RW Error: Failed to write new bits for OTP %d-of-%d: row 0x%03x: 0x%06x --> 0x%06x\n", N, M, start_row+i, old_data, to_write);
-            continue; // to next OTP row, if any
+        size_t run_start = i;
+        while ((i < chunk_rows) && (to_write[i] != old[i])) {
+            ++i;
+        }
+        PRINT_DEBUG("OTP_RW Debug: updating rows 0x%03x..0x%03x\n", chunk_start_row + run_start, chunk_start_row + i - 1u);
+        if (!write_raw_wrapper(chunk_start_row + run_start, &to_write[run_start], (i - run_start) * sizeof(uint32_t))) {
+            PRINT_ERROR("OTP_RW Error: Failed to write new bits for OTP %d-of-%d: rows 0x%03x..0x%03x\n", N, M, chunk_start_row + run_start, chunk_start_row + i - 1u);
         }
-        PRINT_DEBUG("OTP_RW Debug: Wrote new bits for OTP %d-of-%d: row 0x%03x: 0x%06x --> 0x%06x\n", N, M, start_row+i, old_data, to_write);
     }
 
-    // 3. Read the new N of M voted-upon bits
-    uint32_t new_voted_bits;
-    if (!read_single_otp_value_N_of_M(start_row, N, M, &new_voted_bits)) {
-        PRINT_ERROR("OTP_RW Error: Failed to read agreed-upon new bits for OTP %d-of-%d starting at row 0x%03x\n", N, M, start_row);
+    // Verify the new voted-upon values, with a single bulk read of the chunk
+    (void)read_raw_rows_with_fallback(chunk_start_row, old, chunk_rows);
+    for (size_t g = 0; g < chunk_groups; ++g) {
+        uint32_t new_voted_bits;
+        if (!vote_N_of_M(chunk_start_row + (g * M), N, M, &old[g * M], &new_voted_bits)) {
+            PRINT_ERROR("OTP_RW Error: Failed to read agreed-upon new bits for OTP %d-of-%d starting at row 0x%03x\n", N, M, chunk_start_row + (g * M));
+            return false;
+        }
+        if (new_voted_bits != new_values[g]) {
+            PRINT_ERROR("OTP_RW Error: OTP %d-of-%d: starting at row 0x%03x: 0x%06x, but got 0x%06x\n",
+                N, M, chunk_start_row + (g * M), new_values[g], new_voted_bits
+            );
+            return false;
+        }
+    }
+    return true;
+}
+static bool write_otp_N_of_M_data(uint16_t start_row, uint8_t N, uint8_t M, const uint32_t* new_values, size_t group_count) {
+    if (!is_supported_N_of_M(N, M)) {
+        return false;
+    }
+    if (!is_valid_otp_range_raw(start_row, group_count * M * sizeof(uint32_t))) {
+        PRINT_ERROR("OTP_RW Error: Invalid (start row / count) for %d-of-%d: 0x%03x %zu\n", N, M, start_row, group_count);
         return false;
     }
+    uint32_t old[NUM_OTP_PAGE_ROWS];
+    uint32_t to_write[NUM_OTP_PAGE_ROWS];
+    size_t groups_per_chunk = NUM_OTP_PAGE_ROWS / M;
 
-    // 4. Verify the new voted-upon bits match the requested value
-    if (new_voted_bits != new_value) {
-        PRINT_ERROR("OTP_RW Error: OTP %d-of-%d: starting at row 0x%03x: 0x%06x -> 0x%06x, but got 0x%06x\n",
-            N, M, start_row,
-            old_voted_bits, new_value, new_voted_bits
-        );
+    // 1. Read and check the entire range before anything is written.
+    //    Not needed for a single chunk, as step 2 checks it before writing anything.
+    for (size_t chunk = 0; (group_count > groups_per_chunk) && (chunk < group_count); chunk += groups_per_chunk) {
+        size_t chunk_groups = group_count - chunk;
+        if (chunk_groups > groups_per_chunk) {
+            chunk_groups = groups_per_chunk;
+        }
+        if (!plan_N_of_M_chunk(start_row + (chunk * M), N, M, &new_values[chunk], chunk_groups, old, to_write)) {
+            return false;
+        }
+    }
+
+    // 2. Re-plan, program and verify each chunk, with the RMW mutex held
+    for (size_t chunk = 0; chunk < group_count; chunk += groups_per_chunk) {
+        size_t chunk_groups = group_count - chunk;
+        if (chunk_groups > groups_per_chunk) {
+            chunk_groups = groups_per_chunk;
+        }
+        uint16_t chunk_start_row = start_row + (chunk * M);
+        otp_rmw_lock();
+        bool result = plan_N_of_M_chunk(chunk_start_row, N, M, &new_values[chunk], chunk_groups, old, to_write) &&
+                      program_N_of_M_chunk(chunk_start_row, N, M, &new_values[chunk], chunk_groups, old, to_write);
+        otp_rmw_unlock();
+        if (!result) {
+            return false;
+        }
+    }
+    return true;
+}
+static bool read_single_otp_value_N_of_M(uint16_t start_row, uint8_t N, uint8_t M, uint32_t* out_data) {
+    *out_data = 0xFFFFFFFFu;
+    return read_otp_N_of_M_data(start_row, N, M, out_data, 1u);
+}
+static bool write_single_otp_value_N_of_M(uint16_t start_row, uint8_t N, uint8_t M, uint32_t new_value) {
+    PRINT_DEBUG("OTP_RW Debug: Write OTP %d-of-%d: row 0x%03x\n", N, M, start_row);
+    if (!write_otp_N_of_M_data(start_row, N, M, &new_value, 1u)) {
         return false;
     }
     // print success message
@@ -642,6 +1257,11 @@ static bool write_single_otp_value_N_of_M(uint16_t start_row, uint8_t N, uint8_t
     }
     return true;
 }
+// 2-of-3 majority of the three bytes of a BYTE3X row, all eight bits at once
+static inline uint8_t byte_3x_vote(uint32_t raw) {
+    uint32_t a = raw, b = raw >> 8, c = raw >> 16;
+    return (uint8_t)((a & b) | (a & c) | (b & c));
+}
 static bool read_otp_byte_3x(uint16_t row, uint8_t* out_data) {
     *out_data = 0xFFu;
 
@@ -651,20 +1271,10 @@ static bool read_otp_byte_3x(uint16_t row, uint8_t* out_data) {
         PRINT_ERROR("OTP_RW Error: Failed to read OTP byte 3x: row 0x%03x\n", row);
         return false;
     }
-    // use bit-by-bit majority voting
-    uint8_t result = 0u;
+    // 2. majority voting
     PRINT_DEBUG("OTP_RW Debug: Read OTP byte_3x row 0x%03x: (0x%02x, 0x%02x, 0x%02x)\n", row, v.as_bytes[0], v.as_bytes[1], v.as_bytes[2]);
-    for (uint8_t mask = 0x80u; mask; mask >>= 1) {
-        uint_fast8_t count = 0;
-        if (v.as_bytes[0] & mask) { ++count; }
-        if (v.as_bytes[1] & mask) { ++count; }
-        if (v.as_bytes[2] & mask) { ++count; }
-        if (count >= 2) {
-            result |= mask;
-        }
-    }
-
-    PRINT_DEBUG("OTP_RW Debug: Read OTP byte_3x row 0x%03x: Bit-by-bit voting result: 0x%02x\n", row, result);
+    uint8_t result = byte_3x_vote(v.as_uint32);
+    PRINT_DEBUG("OTP_RW Debug: Read OTP byte_3x row 0x%03x: voting result: 0x%02x\n", row, result);
     *out_data = result;
     return true;
 }
@@ -680,23 +1290,14 @@ static bool write_otp_byte_3x(uint16_t row, uint8_t new_value) {
     }
 
     // 2. Does the existing data have bits set that are zero in the new value? (fail ... can never unset those bits)
-    uint8_t check_if_voted_set = ~new_value;
-    for (uint_fast8_t i = 0; i < 8u; ++i) {
-        uint8_t mask = (1u << i);
-        if (check_if_voted_set & mask) {
-            uint_fast8_t count = 0;
-            if (old_raw_data.as_bytes[0] & mask) { ++count; }
-            if (old_raw_data.as_bytes[1] & mask) { ++count; }
-            if (old_raw_data.as_bytes[2] & mask) { ++count; }
-            if (count >= 2) {
-                // found a bit that already has enough votes to be set
-                // and thus cannot be unset (stored as zero in the new raw data)
-                PRINT_ERROR("OTP_RW Error: Attempt to byte_3x write row %03x to 0x%02x; Existing data 0x%06x bit %d votes as set, but is not set in new value\n",
-                    row, new_value, old_raw_data.as_uint32, i
-                );
-                return false;
-            }
-        }
+    uint8_t cannot_unset = byte_3x_vote(old_raw_data.as_uint32) & ~new_value;
+    if (cannot_unset != 0u) {
+        // found a bit that already has enough votes to be set
+        // and thus cannot be unset (stored as zero in the new raw data)
+        PRINT_ERROR("OTP_RW Error: Attempt to byte_3x write row %03x to 0x%02x; Existing data 0x%06x bit %d votes as set, but is not set in new value\n",
+            row, new_value, old_raw_data.as_uint32, __builtin_ctz(cannot_unset)
+        );
+        return false;
     }
 
     // 3. Does the existing data already have all necessary bits set?  If so, SUCCESS w/o writing.
@@ -734,19 +1335,1156 @@ static bool write_otp_byte_3x(uint16_t row, uint8_t new_value) {
     return true;
 }
 
-/// All code above this point are the static helper functions / implementation details.
-/// Only the below are the public API functions.
+#pragma region    // Bulk BYTE3X reads / writes
+#define xBYTE3X_ROWS_PER_CHUNK ((size_t)NUM_OTP_PAGE_ROWS)
+#define xBYTE3X_ALL_COPIES(x)  ((uint32_t)(x) * 0x010101u) // same byte in all three copies
 
-bool saferotp_virtualization_init_pages(uint64_t ignored_pages_mask) {
-    virt_initialize(ignored_pages_mask);
+static bool read_otp_byte_3x_data(uint16_t start_row, uint8_t* out_data, size_t count_of_bytes) {
+    if (!is_valid_otp_range_raw(start_row, count_of_bytes * sizeof(uint32_t))) {
+        PRINT_ERROR("OTP_RW Error: Invalid (start row / byte count) for byte_3x: 0x%03x %zu\n", start_row, count_of_bytes);
+        return false;
+    }
+    uint32_t raw[xBYTE3X_ROWS_PER_CHUNK];
+    for (size_t chunk = 0; chunk < count_of_bytes; chunk += xBYTE3X_ROWS_PER_CHUNK) {
+        size_t chunk_rows = count_of_bytes - chunk;
+        if (chunk_rows > xBYTE3X_ROWS_PER_CHUNK) {
+            chunk_rows = xBYTE3X_ROWS_PER_CHUNK;
+        }
+        if (!read_raw_rows_with_fallback(start_row + chunk, raw, chunk_rows)) {
+            return false;
+        }
+        for (size_t i = 0; i < chunk_rows; ++i) {
+            out_data[chunk + i] = byte_3x_vote(raw[i]);
+        }
+    }
     return true;
 }
-bool saferotp_virtualization_restore(uint16_t starting_row, const void* buffer, size_t buffer_size) {
-    return virt_override_restore(starting_row, buffer, buffer_size);
+// Reads one chunk, and determines the raw value to write to each row (the existing
+// value for rows that already have all bits set).  Returns false if any row cannot
+// be read, or already votes a bit as set that is zero in the new value.
+static bool plan_byte_3x_chunk(uint16_t start_row, const uint8_t* new_values, size_t row_count, uint32_t* out_old, uint32_t* out_to_write) {
+    if (!read_raw_rows_with_fallback(start_row, out_old, row_count)) {
+        return false;
+    }
+    bool result = true;
+    for (size_t i = 0; i < row_count; ++i) {
+        uint8_t cannot_unset = byte_3x_vote(out_old[i]) & ~new_values[i];
+        if (cannot_unset != 0u) {
+            PRINT_ERROR("OTP_RW Error: Attempt to byte_3x write row %03x to 0x%02x; Existing data 0x%06x bit %d votes as set, but is not set in new value\n",
+                start_row + i, new_values[i], out_old[i], __builtin_ctz(cannot_unset)
+            );
+            result = false;
+        }
+        out_to_write[i] = out_old[i] | xBYTE3X_ALL_COPIES(new_values[i]);
+    }
+    return result;
 }
-bool saferotp_virtualization_save(uint16_t starting_row, void* buffer, size_t buffer_size) {
+// Writes one planned chunk, then verifies it.  Caller holds the RMW mutex.
+static bool program_byte_3x_chunk(uint16_t chunk_start_row, const uint8_t* new_values, size_t chunk_rows, uint32_t* old, const uint32_t* to_write) {
+    // OR the new bits into each contiguous run of rows that change
+    size_t i = 0;
+    while (i < chunk_rows) {
+        if (to_write[i] == old[i]) {
+            ++i;
+            continue;
+        }
+        size_t run_start = i;
+        while ((i < chunk_rows) && (to_write[i] != old[i])) {
+            ++i;
+        }
+        if (!write_raw_wrapper(chunk_start_row + run_start, &to_write[run_start], (i - run_start) * sizeof(uint32_t))) {
+            PRINT_ERROR("OTP_RW Error: Failed to write new bits for byte_3x: rows 0x%03x..0x%03x\n", chunk_start_row + run_start, chunk_start_row + i - 1u);
+            return false;
+        }
+    }
+
+    // Verify the chunk with a single bulk read
+    if (!read_raw_rows_with_fallback(chunk_start_row, old, chunk_rows)) {
+        return false;
+    }
+    for (size_t j = 0; j < chunk_rows; ++j) {
+        uint8_t voted = byte_3x_vote(old[j]);
+        if (voted != new_values[j]) {
+            PRINT_ERROR("OTP_RW Error: OTP byte_3x: row 0x%03x: 0x%02x (raw 0x%06x), but got 0x%02x\n",
+                chunk_start_row + j, new_values[j], old[j], voted
+            );
+            return false;
+        }
+    }
+    return true;
+}
+static bool write_otp_byte_3x_data(uint16_t start_row, const uint8_t* data, size_t count_of_bytes) {
+    if (!is_valid_otp_range_raw(start_row, count_of_bytes * sizeof(uint32_t))) {
+        PRINT_ERROR("OTP_RW Error: Invalid (start row / byte count) for byte_3x: 0x%03x %zu\n", start_row, count_of_bytes);
+        return false;
+    }
+    uint32_t old[xBYTE3X_ROWS_PER_CHUNK];
+    uint32_t to_write[xBYTE3X_ROWS_PER_CHUNK];
+
+    // 1. Check the entire range before anything is written
+    for (size_t chunk = 0; chunk < count_of_bytes; chunk += xBYTE3X_ROWS_PER_CHUNK) {
+        size_t chunk_rows = count_of_bytes - chunk;
+        if (chunk_rows > xBYTE3X_ROWS_PER_CHUNK) {
+            chunk_rows = xBYTE3X_ROWS_PER_CHUNK;
+        }
+        if (!plan_byte_3x_chunk(start_row + chunk, data + chunk, chunk_rows, old, to_write)) {
+            return false;
+        }
+    }
+
+    // 2. Re-plan, program and verify each chunk, with the RMW mutex held
+    for (size_t chunk = 0; chunk < count_of_bytes; chunk += xBYTE3X_ROWS_PER_CHUNK) {
+        size_t chunk_rows = count_of_bytes - chunk;
+        if (chunk_rows > xBYTE3X_ROWS_PER_CHUNK) {
+            chunk_rows = xBYTE3X_ROWS_PER_CHUNK;
+        }
+        uint16_t chunk_start_row = start_row + chunk;
+        otp_rmw_lock();
+        bool result = plan_byte_3x_chunk(chunk_start_row, data + chunk, chunk_rows, old, to_write) &&
+                      program_byte_3x_chunk(chunk_start_row, data + chunk, chunk_rows, old, to_write);
+        otp_rmw_unlock();
+        if (!result) {
+            return false;
+        }
+    }
+    return true;
+}
+#pragma endregion // Bulk BYTE3X reads / writes
+
+#pragma region    // Planned bulk ECC writes
+// Writing a range of ECC rows one row at a time costs at least three bootrom calls
+// per row, and a row that cannot be written is only discovered after the rows
+// before it were already burned.  Instead, the range is processed in four steps:
+//   1. Read the entire range (in bulk), and plan every row.
+//   2. Reject the range if any row cannot be written ... before anything is burned.
+//   3. Program the rows that change, in contiguous runs (one bootrom call per run).
+//   4. Verify each chunk with a single bulk read.
+// The RMW mutex is held for the whole write, so no other write can change the rows
+// between planning and programming.  Each chunk is up to one OTP page (64 rows), which
+// bounds the stack use (~1k).  Steps 1 and 2 check the chunks from last to first, so
+// the plan for the first chunk is still held when step 3 starts: a range of up to one
+// page is read once to plan, and once more to verify.  A longer range must check
+// every chunk before burning anything, and only one chunk's plan fits on the stack,
+// so each later chunk is read (and planned) again just before it is programmed.
+#define xPLANNED_ROWS_PER_CHUNK NUM_OTP_PAGE_ROWS
+
+// Gets the 16-bit values for `row_count` rows starting at `first_row` of the caller's buffer.
+// The final row of an odd byte count is padded with a zero byte.
+static void gather_ecc_row_values(const void* data, size_t count_of_bytes, size_t first_row, size_t row_count, uint16_t* out_values) {
+    const uint8_t * b = (const uint8_t*)data; // byte-based pointer, as only one byte of the final row may be valid
+    for (size_t i = 0; i < row_count; ++i) {
+        size_t byte_index = (first_row + i) * 2u;
+        uint16_t value = b[byte_index];
+        if ((byte_index + 1u) < count_of_bytes) {
+            value |= (uint16_t)(b[byte_index + 1u] << 8);
+        }
+        out_values[i] = value;
+    }
+}
+// Reads and plans one chunk.  Returns false if any row cannot be read or written.
+static bool plan_ecc_chunk(uint16_t start_row, const uint16_t* values, size_t row_count, SAFEROTP_ECC_WRITE_PLAN* out_plan) {
+    uint32_t raw[xPLANNED_ROWS_PER_CHUNK];
+    (void)read_raw_rows_with_fallback(start_row, raw, row_count); // unreadable rows are planned as impossible
+    if (saferotp_plan_ecc_writes(raw, values, out_plan, row_count) == 0u) {
+        return true;
+    }
+    for (size_t i = 0; i < row_count; ++i) {
+        if (out_plan[i].action == SAFEROTP_ECC_WRITE_PLAN_IMPOSSIBLE) {
+            PRINT_ERROR("OTP_RW Error: Cannot write ECC OTP row %03x with data 0x%04x (existing 0x%06x)\n",
+                start_row + i, values[i], raw[i]
+            );
+        }
+    }
+    return false;
+}
+// Steps 3 and 4 for one planned chunk.  Caller holds the RMW mutex.
+static bool program_ecc_chunk(uint16_t chunk_start_row, const uint16_t* values, size_t chunk_rows, const SAFEROTP_ECC_WRITE_PLAN* plan) {
+    uint32_t raw[xPLANNED_ROWS_PER_CHUNK];
+
+    // 3. Program each contiguous run of rows that need writing.
+    size_t i = 0;
+    while (i < chunk_rows) {
+        if (plan[i].action == SAFEROTP_ECC_WRITE_PLAN_NO_WRITE) {
+            ++i;
+            continue;
+        }
+        size_t run_start = i;
+        while ((i < chunk_rows) && (plan[i].action != SAFEROTP_ECC_WRITE_PLAN_NO_WRITE)) {
+            if (plan[i].action == SAFEROTP_ECC_WRITE_PLAN_WRITE_DEGRADED) {
+                PRINT_WARNING("OTP_RW WARN: Writing ECC OTP row %03x with data 0x%06x: Redundancy compromised, but still decodable.\n",
+                    chunk_start_row + i, plan[i].raw_to_write
+                );
+            }
+            raw[i] = plan[i].raw_to_write;
+            ++i;
+        }
+        if (!write_raw_wrapper(chunk_start_row + run_start, &raw[run_start], (i - run_start) * sizeof(uint32_t))) {
+            PRINT_ERROR("OTP_RW Error: Failed to write ECC OTP rows %03x..%03x\n", chunk_start_row + run_start, chunk_start_row + i - 1u);
+            return false;
+        }
+    }
+
+    // 4. Verify the entire chunk with a single bulk read
+    (void)read_raw_rows_with_fallback(chunk_start_row, raw, chunk_rows);
+    saferotp_decode_raw_batch(raw, raw, chunk_rows);
+    for (size_t j = 0; j < chunk_rows; ++j) {
+        if (raw[j] != values[j]) {
+            PRINT_ERROR("OTP_RW Error: Failed to verify ECC OTP row %03x has data 0x%04x (result 0x%08x)\n", chunk_start_row + j, values[j], raw[j]);
+            return false;
+        }
+    }
+    return true;
+}
+// Caller holds the RMW mutex.
+static bool write_otp_ecc_data_planned_locked(uint16_t start_row, const void* data, size_t count_of_bytes, size_t row_count) {
+    uint16_t values[xPLANNED_ROWS_PER_CHUNK];
+    SAFEROTP_ECC_WRITE_PLAN plan[xPLANNED_ROWS_PER_CHUNK];
+    size_t last_chunk = ((row_count - 1u) / xPLANNED_ROWS_PER_CHUNK) * xPLANNED_ROWS_PER_CHUNK;
+
+    // 1 & 2. Plan the entire range, last chunk first; reject before anything is burned.
+    for (size_t chunk = last_chunk + xPLANNED_ROWS_PER_CHUNK; chunk != 0u; ) {
+        chunk -= xPLANNED_ROWS_PER_CHUNK;
+        size_t chunk_rows = row_count - chunk;
+        if (chunk_rows > xPLANNED_ROWS_PER_CHUNK) {
+            chunk_rows = xPLANNED_ROWS_PER_CHUNK;
+        }
+        gather_ecc_row_values(data, count_of_bytes, chunk, chunk_rows, values);
+        if (!plan_ecc_chunk(start_row + chunk, values, chunk_rows, plan)) {
+            return false;
+        }
+    }
+
+    // 3 & 4. The first chunk's plan (and values) are still current.
+    for (size_t chunk = 0; chunk < row_count; chunk += xPLANNED_ROWS_PER_CHUNK) {
+        size_t chunk_rows = row_count - chunk;
+        if (chunk_rows > xPLANNED_ROWS_PER_CHUNK) {
+            chunk_rows = xPLANNED_ROWS_PER_CHUNK;
+        }
+        uint16_t chunk_start_row = start_row + chunk;
+        if (chunk != 0u) {
+            gather_ecc_row_values(data, count_of_bytes, chunk, chunk_rows, values);
+            if (!plan_ecc_chunk(chunk_start_row, values, chunk_rows, plan)) {
+                return false;
+            }
+        }
+        if (!program_ecc_chunk(chunk_start_row, values, chunk_rows, plan)) {
+            return false;
+        }
+    }
+    return true;
+}
+static bool write_otp_ecc_data_planned(uint16_t start_row, const void* data, size_t count_of_bytes) {
+    size_t row_count = (count_of_bytes + 1u) / 2u;
+    if (row_count == 0u) {
+        return true;
+    }
+    if (!is_valid_otp_range_raw(start_row, row_count * sizeof(uint32_t))) {
+        PRINT_ERROR("OTP_RW Error: Invalid (start row / byte count): 0x%03x %zu\n", start_row, count_of_bytes);
+        return false;
+    }
+    otp_rmw_lock();
+    bool result = write_otp_ecc_data_planned_locked(start_row, data, count_of_bytes, row_count);
+    otp_rmw_unlock();
+    return result;
+}
+#pragma endregion // Planned bulk ECC writes
+
+#pragma region    // `ECC_RS` - Reed-Solomon erasure code layered over ECC rows
+// Each OTP row stores 16 bits using the normal ECC encoding.  A blob of `k` data rows
+// is followed by `p` parity rows (systematic Reed-Solomon code over GF(2^8), using a
+// Cauchy matrix).  Each row holds two independent byte lanes (low / high byte), and
+// both lanes share the same erasure positions.
+//
+// ECC already corrects single-bit errors within a row.  Any row that fails to read
+// or decode is treated as an erasure, and up to `p` erased rows are rebuilt from the
+// parity rows.  Any parity rows not needed for the rebuild are used to verify the result.
+//
+// Cost: `p` extra rows per blob, vs. 3x (BYTE3X / RBIT3) or 8x (RBIT8) the rows.
+//
+// Limits: at most one OTP page (64 rows) per blob, and at most 8 parity rows.
+#define xRS_MAX_BLOB_ROWS   ((size_t)NUM_OTP_PAGE_ROWS)
+#define xRS_MAX_PARITY_ROWS (8u)
+#define xRS_PARITY_X_BASE   (0x80u) // Cauchy x_j = 0x80 + j; y_i = i (data row index < 64) ... never equal
+static_assert(xRS_MAX_BLOB_ROWS <= xRS_PARITY_X_BASE, "Cauchy matrix requires x_j != y_i");
+
+// GF(2^8), polynomial x^8 + x^4 + x^3 + x^2 + 1 (0x11D)
+static uint8_t rs_gf_mul(uint8_t a, uint8_t b) {
+    uint8_t result = 0u;
+    while (b != 0u) {
+        if (b & 1u) {
+            result ^= a;
+        }
+        a = (uint8_t)((a << 1) ^ ((a & 0x80u) ? 0x1Du : 0x00u));
+        b >>= 1;
+    }
+    return result;
+}
+static uint8_t rs_gf_inv(uint8_t a) {
+    // a^254 == a^-1 for non-zero a
+    uint8_t result = 1u;
+    for (uint_fast8_t i = 0u; i < 7u; ++i) {
+        a = rs_gf_mul(a, a);
+        result = rs_gf_mul(result, a);
+    }
+    return result;
+}
+// multiplies both byte lanes of an OTP row's data
+static uint16_t rs_gf_mul_row(uint8_t c, uint16_t v) {
+    return (uint16_t)(rs_gf_mul(c, (uint8_t)v) | (rs_gf_mul(c, (uint8_t)(v >> 8)) << 8));
+}
+static uint8_t rs_cauchy(uint8_t parity_index, uint8_t data_index) {
+    return rs_gf_inv((uint8_t)((xRS_PARITY_X_BASE + parity_index) ^ data_index));
+}
+static uint16_t rs_calculate_parity_row(const uint16_t* data_rows, size_t data_row_count, uint8_t parity_index) {
+    uint16_t result = 0u;
+    for (size_t i = 0u; i < data_row_count; ++i) {
+        result ^= rs_gf_mul_row(rs_cauchy(parity_index, (uint8_t)i), data_rows[i]);
+    }
+    return result;
+}
+static bool rs_is_valid_blob(size_t count_of_bytes, uint8_t parity_rows, size_t* out_data_row_count) {
+    size_t data_row_count = (count_of_bytes + 1u) / 2u;
+    *out_data_row_count = data_row_count;
+    if (count_of_bytes == 0u) {
+        PRINT_ERROR("OTP_RW Error: ECC_RS blob requires non-zero byte count\n");
+        return false;
+    }
+    if ((parity_rows == 0u) || (parity_rows > xRS_MAX_PARITY_ROWS)) {
+        PRINT_ERROR("OTP_RW Error: ECC_RS blob parity rows must be 1..%d (got %d)\n", xRS_MAX_PARITY_ROWS, parity_rows);
+        return false;
+    }
+    if (data_row_count + parity_rows > xRS_MAX_BLOB_ROWS) {
+        PRINT_ERROR("OTP_RW Error: ECC_RS blob of %zu bytes + %d parity rows exceeds %zu rows\n", count_of_bytes, parity_rows, xRS_MAX_BLOB_ROWS);
+        return false;
+    }
+    return true;
+}
+// Rebuilds the erased data rows, using the same count of readable parity rows.
+// Solves the (erasures x erasures) Cauchy sub-matrix system with Gauss-Jordan elimination.
+static bool rs_rebuild_erased_rows(uint16_t* rows, const bool* erased, size_t data_row_count, uint8_t parity_rows) {
+    uint8_t erased_data[xRS_MAX_PARITY_ROWS];
+    uint8_t used_parity[xRS_MAX_PARITY_ROWS];
+    uint_fast8_t erased_count = 0u;
+    uint_fast8_t parity_count = 0u;
+    for (size_t i = 0u; i < data_row_count; ++i) {
+        if (erased[i]) {
+            if (erased_count == xRS_MAX_PARITY_ROWS) {
+                return false;
+            }
+            erased_data[erased_count++] = (uint8_t)i;
+        }
+    }
+    for (uint_fast8_t j = 0u; (j < parity_rows) && (parity_count < erased_count); ++j) {
+        if (!erased[data_row_count + j]) {
+            used_parity[parity_count++] = j;
+        }
+    }
+    if (parity_count < erased_count) {
+        return false;
+    }
+
+    // Matrix A (erasures x erasures) and the right-hand side (both byte lanes)
+    uint8_t  a[xRS_MAX_PARITY_ROWS][xRS_MAX_PARITY_ROWS];
+    uint16_t rhs[xRS_MAX_PARITY_ROWS];
+    for (uint_fast8_t r = 0u; r < erased_count; ++r) {
+        uint8_t j = used_parity[r];
+        rhs[r] = rows[data_row_count + j];
+        for (size_t i = 0u; i < data_row_count; ++i) {
+            if (!erased[i]) {
+                rhs[r] ^= rs_gf_mul_row(rs_cauchy(j, (uint8_t)i), rows[i]);
+            }
+        }
+        for (uint_fast8_t c = 0u; c < erased_count; ++c) {
+            a[r][c] = rs_cauchy(j, erased_data[c]);
+        }
+    }
+    for (uint_fast8_t c = 0u; c < erased_count; ++c) {
+        // Cauchy sub-matrices are never singular, so a pivot always exists
+        uint_fast8_t pivot = c;
+        while ((pivot < erased_count) && (a[pivot][c] == 0u)) {
+            ++pivot;
+        }
+        if (pivot == erased_count) {
+            return false;
+        }
+        if (pivot != c) {
+            for (uint_fast8_t k = 0u; k < erased_count; ++k) {
+                uint8_t t = a[c][k]; a[c][k] = a[pivot][k]; a[pivot][k] = t;
+            }
+            uint16_t t = rhs[c]; rhs[c] = rhs[pivot]; rhs[pivot] = t;
+        }
+        uint8_t scale = rs_gf_inv(a[c][c]);
+        for (uint_fast8_t k = 0u; k < erased_count; ++k) {
+            a[c][k] = rs_gf_mul(scale, a[c][k]);
+        }
+        rhs[c] = rs_gf_mul_row(scale, rhs[c]);
+        for (uint_fast8_t r = 0u; r < erased_count; ++r) {
+            uint8_t factor = a[r][c];
+            if ((r == c) || (factor == 0u)) {
+                continue;
+            }
+            for (uint_fast8_t k = 0u; k < erased_count; ++k) {
+                a[r][k] ^= rs_gf_mul(factor, a[c][k]);
+            }
+            rhs[r] ^= rs_gf_mul_row(factor, rhs[c]);
+        }
+    }
+    for (uint_fast8_t c = 0u; c < erased_count; ++c) {
+        rows[erased_data[c]] = rhs[c];
+    }
+    return true;
+}
+static bool read_otp_ecc_rs_blob(uint16_t start_row, void* out_data, size_t count_of_bytes, uint8_t parity_rows) {
+    size_t data_row_count;
+    if (!rs_is_valid_blob(count_of_bytes, parity_rows, &data_row_count)) {
+        return false;
+    }
+    size_t row_count = data_row_count + parity_rows;
+    if (!is_valid_otp_range_raw(start_row, row_count * sizeof(uint32_t))) {
+        PRINT_ERROR("OTP_RW Error: Invalid (start row / row count) for ECC_RS blob: 0x%03x %zu\n", start_row, row_count);
+        return false;
+    }
+
+    // 1. Bulk read all rows; rows that fail to read or decode become erasures
+    uint32_t raw[xRS_MAX_BLOB_ROWS];
+    uint16_t rows[xRS_MAX_BLOB_ROWS];
+    bool     erased[xRS_MAX_BLOB_ROWS];
+    uint_fast8_t erased_count = 0u;
+    (void)read_raw_rows_with_fallback(start_row, raw, row_count);
+    for (size_t i = 0u; i < row_count; ++i) {
+        uint32_t decoded = saferotp_decode_raw(raw[i]);
+        erased[i] = ((decoded & 0xFF000000u) != 0u);
+        rows[i]   = erased[i] ? 0u : (uint16_t)decoded;
+        if (erased[i]) {
+            PRINT_WARNING("OTP_RW Warn: ECC_RS blob at %03x: row %03x is an erasure (raw 0x%08x)\n", start_row, start_row + i, raw[i]);
+            ++erased_count;
+        }
+    }
+    if (erased_count > parity_rows) {
+        PRINT_ERROR("OTP_RW Error: ECC_RS blob at %03x: %d unreadable rows exceeds %d parity rows\n", start_row, erased_count, parity_rows);
+        return false;
+    }
+
+    // 2. Rebuild any erased data rows
+    if (!rs_rebuild_erased_rows(rows, erased, data_row_count, parity_rows)) {
+        PRINT_ERROR("OTP_RW Error: ECC_RS blob at %03x: failed to rebuild erased rows\n", start_row);
+        return false;
+    }
+
+    // 3. Verify every readable parity row agrees with the (rebuilt) data
+    for (uint_fast8_t j = 0u; j < parity_rows; ++j) {
+        if (erased[data_row_count + j]) {
+            continue;
+        }
+        if (rows[data_row_count + j] != rs_calculate_parity_row(rows, data_row_count, j)) {
+            PRINT_ERROR("OTP_RW Error: ECC_RS blob at %03x: parity row %d does not match data\n", start_row, j);
+            return false;
+        }
+    }
+
+    // 4. Copy out the data; for odd byte counts, only the low byte of the final row is used.
+    uint8_t * b = (uint8_t*)out_data;
+    for (size_t i = 0u; i < count_of_bytes; ++i) {
+        b[i] = (uint8_t)(rows[i / 2u] >> ((i & 1u) ? 8 : 0));
+    }
+    return true;
+}
+static bool write_otp_ecc_rs_blob(uint16_t start_row, const void* data, size_t count_of_bytes, uint8_t parity_rows) {
+    size_t data_row_count;
+    if (!rs_is_valid_blob(count_of_bytes, parity_rows, &data_row_count)) {
+        return false;
+    }
+    // Data rows (zero-padded to a whole row), followed by the parity rows
+    uint16_t rows[xRS_MAX_BLOB_ROWS] = {0u};
+    const uint8_t * b = (const uint8_t*)data;
+    for (size_t i = 0u; i < count_of_bytes; ++i) {
+        rows[i / 2u] |= (uint16_t)(b[i] << ((i & 1u) ? 8 : 0));
+    }
+    for (uint_fast8_t j = 0u; j < parity_rows; ++j) {
+        rows[data_row_count + j] = rs_calculate_parity_row(rows, data_row_count, j);
+    }
+    return saferotp_write_data_ecc(start_row, rows, (data_row_count + parity_rows) * sizeof(uint16_t));
+}
+#pragma endregion // `ECC_RS` - Reed-Solomon erasure code layered over ECC rows
+
+#pragma region    // Scatter / gather (vectored) reads and writes
+// saferotp_readv() / saferotp_writev() sweep the rows of all the descriptors in
+// ascending order, one window at a time.  Each window is a contiguous span of rows
+// covered by the descriptors (adjacent and overlapping ranges are merged), at most
+// one page of rows, and is fetched with a single raw access.  Each descriptor then
+// decodes (or, for writes, checks) every unit -- one row, or one group of 3 / 8 rows --
+// lying entirely within the window.  A unit that straddles the end of a window
+// starts the next window, so descriptors need no state between windows, and
+// the descriptors never need to be sorted.
+
+static size_t iov_rows_per_unit(const SAFEROTP_IOV* v) {
+    if (v->encoding == SAFEROTP_IOV_ENCODING_RBIT3) {
+        return 3u;
+    } else if (v->encoding == SAFEROTP_IOV_ENCODING_RBIT8) {
+        return 8u;
+    }
+    return 1u;
+}
+// Count of rows used by the descriptor, or zero if the encoding / size is not valid.
+static size_t iov_row_count(const SAFEROTP_IOV* v) {
+    size_t bytes = v->count_of_bytes;
+    if ((v->buffer == NULL) || (bytes == 0u) || (bytes > (NUM_OTP_ROWS * sizeof(uint32_t)))) {
+        return 0u;
+    }
+    switch (v->encoding) {
+        case SAFEROTP_IOV_ENCODING_RAW:
+        case SAFEROTP_IOV_ENCODING_RBIT3:
+        case SAFEROTP_IOV_ENCODING_RBIT8: {
+            if ((bytes % sizeof(uint32_t)) != 0u) {
+                return 0u;
+            }
+            return (bytes / sizeof(uint32_t)) * iov_rows_per_unit(v);
+        }
+        case SAFEROTP_IOV_ENCODING_ECC: {
+            return (bytes + 1u) / 2u;
+        }
+        case SAFEROTP_IOV_ENCODING_BYTE3X: {
+            return bytes;
+        }
+        default: {
+            return 0u;
+        }
+    }
+}
+// Sets each descriptor's status to OK or INVALID.  For writes, overlapping descriptors are INVALID.
+// Returns false if any descriptor is INVALID.
+static bool iov_validate(SAFEROTP_IOV* iov, size_t iov_count, bool reject_overlaps) {
+    bool result = true;
+    for (size_t i = 0; i < iov_count; ++i) {
+        size_t rows = iov_row_count(&iov[i]);
+        if ((rows == 0u) || !is_valid_otp_range_raw(iov[i].start_row, rows * sizeof(uint32_t))) {
+            PRINT_ERROR("OTP_RW Error: iov[%zu]: invalid encoding %d / start row 0x%03x / byte count %zu\n",
+                i, iov[i].encoding, iov[i].start_row, iov[i].count_of_bytes
+            );
+            iov[i].status = SAFEROTP_IOV_STATUS_INVALID;
+            result = false;
+            continue;
+        }
+        iov[i].status = SAFEROTP_IOV_STATUS_OK;
+    }
+    for (size_t i = 0; reject_overlaps && (i < iov_count); ++i) {
+        size_t i_end = iov[i].start_row + iov_row_count(&iov[i]);
+        for (size_t j = i + 1u; j < iov_count; ++j) {
+            size_t j_end = iov[j].start_row + iov_row_count(&iov[j]);
+            if ((iov[i].start_row < j_end) && (iov[j].start_row < i_end)) {
+                PRINT_ERROR("OTP_RW Error: iov[%zu] and iov[%zu] overlap (rows 0x%03x and 0x%03x)\n", i, j, iov[i].start_row, iov[j].start_row);
+                iov[i].status = SAFEROTP_IOV_STATUS_INVALID;
+                iov[j].status = SAFEROTP_IOV_STATUS_INVALID;
+                result = false;
+            }
+        }
+    }
+    return result;
+}
+// Decodes one unit of the descriptor from its raw rows (unreadable rows are 0xFFFFFFFFu).
+static bool iov_read_unit(SAFEROTP_IOV* v, size_t unit, const uint32_t* raw) {
+    uint16_t row = v->start_row + (unit * iov_rows_per_unit(v));
+    uint8_t * b = (uint8_t*)v->buffer;
+    switch (v->encoding) {
+        case SAFEROTP_IOV_ENCODING_RAW: {
+            if ((raw[0] & 0xFF000000u) != 0u) {
+                return false;
+            }
+            ((uint32_t*)v->buffer)[unit] = raw[0];
+            return true;
+        }
+        case SAFEROTP_IOV_ENCODING_ECC: {
+            uint32_t decode_result = saferotp_decode_raw(raw[0]);
+            if ((decode_result & 0xFF000000u) != 0u) {
+                PRINT_ERROR("OTP_RW Error: Failed to decode OTP row %03x: Result 0x%08x\n", row, decode_result);
+                return false;
+            }
+            b[2u * unit] = (uint8_t)decode_result;
+            if (((2u * unit) + 1u) < v->count_of_bytes) {
+                b[(2u * unit) + 1u] = (uint8_t)(decode_result >> 8);
+            }
+            return true;
+        }
+        case SAFEROTP_IOV_ENCODING_BYTE3X: {
+            if ((raw[0] & 0xFF000000u) != 0u) {
+                return false;
+            }
+            b[unit] = byte_3x_vote(raw[0]);
+            return true;
+        }
+        case SAFEROTP_IOV_ENCODING_RBIT3: {
+            return vote_N_of_M(row, 2, 3, raw, &((uint32_t*)v->buffer)[unit]);
+        }
+        case SAFEROTP_IOV_ENCODING_RBIT8: {
+            return vote_N_of_M(row, 3, 8, raw, &((uint32_t*)v->buffer)[unit]);
+        }
+        default: {
+            return false;
+        }
+    }
+}
+// Checks that one unit of the descriptor can be written, given its existing raw rows.
+// Same checks as the single-range write functions make before writing anything.
+static bool iov_is_unit_writable(const SAFEROTP_IOV* v, size_t unit, const uint32_t* raw) {
+    uint16_t row = v->start_row + (unit * iov_rows_per_unit(v));
+    const uint8_t * b = (const uint8_t*)v->buffer;
+    switch (v->encoding) {
+        case SAFEROTP_IOV_ENCODING_RAW: {
+            uint32_t new_value = ((const uint32_t*)v->buffer)[unit];
+            if (((new_value | raw[0]) & 0xFF000000u) != 0u) {
+                PRINT_ERROR("OTP_RW Error: Cannot write raw OTP row %03x with 0x%08x (existing 0x%08x)\n", row, new_value, raw[0]);
+                return false;
+            }
+            uint32_t incompatible_bits = raw[0] & ~new_value;
+            if (incompatible_bits != 0u) {
+                PRINT_ERROR("OTP_RW Error: OTP row %03x cannot be written to %06x (existing data 0x%06x has incompatible bits at 0x%06x)\n",
+                    row, new_value, raw[0], incompatible_bits
+                );
+                return false;
+            }
+            return true;
+        }
+        case SAFEROTP_IOV_ENCODING_ECC: {
+            uint16_t value;
+            SAFEROTP_ECC_WRITE_PLAN plan;
+            gather_ecc_row_values(v->buffer, v->count_of_bytes, unit, 1u, &value);
+            if (saferotp_plan_ecc_writes(raw, &value, &plan, 1u) != 0u) {
+                PRINT_ERROR("OTP_RW Error: Cannot write ECC OTP row %03x with data 0x%04x (existing 0x%06x)\n", row, value, raw[0]);
+                return false;
+            }
+            return true;
+        }
+        case SAFEROTP_IOV_ENCODING_BYTE3X: {
+            if ((raw[0] & 0xFF000000u) != 0u) {
+                PRINT_ERROR("OTP_RW Error: unable to read old bits for OTP byte_3x: row 0x%03x\n", row);
+                return false;
+            }
+            uint8_t cannot_unset = byte_3x_vote(raw[0]) & ~b[unit];
+            if (cannot_unset != 0u) {
+                PRINT_ERROR("OTP_RW Error: Attempt to byte_3x write row %03x to 0x%02x; Existing data 0x%06x bit %d votes as set, but is not set in new value\n",
+                    row, b[unit], raw[0], __builtin_ctz(cannot_unset)
+                );
+                return false;
+            }
+            return true;
+        }
+        case SAFEROTP_IOV_ENCODING_RBIT3: {
+            return is_N_of_M_group_writable(row, 2, 3, ((const uint32_t*)v->buffer)[unit], raw);
+        }
+        case SAFEROTP_IOV_ENCODING_RBIT8: {
+            return is_N_of_M_group_writable(row, 3, 8, ((const uint32_t*)v->buffer)[unit], raw);
+        }
+        default: {
+            return false;
+        }
+    }
+}
+// Plans the raw values to write for one (already checked) unit of the descriptor.
+// `to_write` starts as a copy of the existing raw rows; rows needing no change are left as-is.
+static void iov_plan_unit(const SAFEROTP_IOV* v, size_t unit, const uint32_t* raw, uint32_t* to_write) {
+    uint16_t row = v->start_row + (unit * iov_rows_per_unit(v));
+    const uint8_t * b = (const uint8_t*)v->buffer;
+    switch (v->encoding) {
+        case SAFEROTP_IOV_ENCODING_RAW: {
+            to_write[0] = ((const uint32_t*)v->buffer)[unit];
+            break;
+        }
+        case SAFEROTP_IOV_ENCODING_ECC: {
+            uint16_t value;
+            SAFEROTP_ECC_WRITE_PLAN plan;
+            gather_ecc_row_values(v->buffer, v->count_of_bytes, unit, 1u, &value);
+            (void)saferotp_plan_ecc_writes(raw, &value, &plan, 1u);
+            if ((plan.action == SAFEROTP_ECC_WRITE_PLAN_WRITE) || (plan.action == SAFEROTP_ECC_WRITE_PLAN_WRITE_DEGRADED)) {
+                to_write[0] = plan.raw_to_write;
+            }
+            break;
+        }
+        case SAFEROTP_IOV_ENCODING_BYTE3X: {
+            to_write[0] = raw[0] | xBYTE3X_ALL_COPIES(b[unit]);
+            break;
+        }
+        case SAFEROTP_IOV_ENCODING_RBIT3: {
+            plan_N_of_M_group(row, 2, 3, ((const uint32_t*)v->buffer)[unit], raw, to_write);
+            break;
+        }
+        case SAFEROTP_IOV_ENCODING_RBIT8: {
+            plan_N_of_M_group(row, 3, 8, ((const uint32_t*)v->buffer)[unit], raw, to_write);
+            break;
+        }
+        default: {
+            break;
+        }
+    }
+}
+// Checks that one unit of the descriptor reads back as the descriptor's data.
+static bool iov_verify_unit(const SAFEROTP_IOV* v, size_t unit, const uint32_t* raw) {
+    uint16_t row = v->start_row + (unit * iov_rows_per_unit(v));
+    const uint8_t * b = (const uint8_t*)v->buffer;
+    switch (v->encoding) {
+        case SAFEROTP_IOV_ENCODING_RAW: {
+            return raw[0] == ((const uint32_t*)v->buffer)[unit];
+        }
+        case SAFEROTP_IOV_ENCODING_ECC: {
+            uint16_t value;
+            gather_ecc_row_values(v->buffer, v->count_of_bytes, unit, 1u, &value);
+            return saferotp_decode_raw(raw[0]) == value;
+        }
+        case SAFEROTP_IOV_ENCODING_BYTE3X: {
+            return ((raw[0] & 0xFF000000u) == 0u) && (byte_3x_vote(raw[0]) == b[unit]);
+        }
+        case SAFEROTP_IOV_ENCODING_RBIT3:
+        case SAFEROTP_IOV_ENCODING_RBIT8: {
+            uint32_t result;
+            uint8_t N = (v->encoding == SAFEROTP_IOV_ENCODING_RBIT3) ? 2u : 3u;
+            uint8_t M = (uint8_t)iov_rows_per_unit(v);
+            return vote_N_of_M(row, N, M, raw, &result) && (result == ((const uint32_t*)v->buffer)[unit]);
+        }
+        default: {
+            return false;
+        }
+    }
+}
+typedef enum _IOV_SWEEP_MODE {
+    IOV_SWEEP_READ         = 0, // decode into the buffers                 (failure: READ_FAILED)
+    IOV_SWEEP_CHECK_WRITES = 1, // check every unit can be written         (failure: WRITE_IMPOSSIBLE)
+    IOV_SWEEP_PROGRAM      = 2, // program every (checked) unit, in runs   (failures are found by IOV_SWEEP_VERIFY)
+    IOV_SWEEP_VERIFY       = 3, // check every unit reads back as written  (failure: WRITE_FAILED)
+} IOV_SWEEP_MODE;
+// Handles (per `mode`) every unit of every descriptor whose status is OK.
+// The first unit that fails sets the descriptor's status, and its remaining units are skipped.
+static void iov_sweep(SAFEROTP_IOV* iov, size_t iov_count, IOV_SWEEP_MODE mode) {
+    uint32_t raw[NUM_OTP_PAGE_ROWS];
+    uint32_t to_write[NUM_OTP_PAGE_ROWS];
+    size_t cursor = 0u; // every unit ending at or before this row is done
+    while (true) {
+        // 1. The window starts at the first unit (of any descriptor) not yet done
+        size_t window_start = NUM_OTP_ROWS;
+        for (size_t i = 0; i < iov_count; ++i) {
+            if (iov[i].status != SAFEROTP_IOV_STATUS_OK) {
+                continue;
+            }
+            size_t first = iov[i].start_row;
+            size_t end = first + iov_row_count(&iov[i]);
+            if (end <= cursor) {
+                continue;
+            }
+            if (first < cursor) {
+                size_t unit_rows = iov_rows_per_unit(&iov[i]);
+                first += ((cursor - first) / unit_rows) * unit_rows;
+            }
+            if (first < window_start) {
+                window_start = first;
+            }
+        }
+        if (window_start == NUM_OTP_ROWS) {
+            return; // all done
+        }
+
+        // 2. Extend the window over contiguous rows covered by any descriptor, up to a page of rows
+        size_t window_limit = window_start + NUM_OTP_PAGE_ROWS;
+        size_t window_end = window_start;
+        bool extended;
+        do {
+            extended = false;
+            for (size_t i = 0; i < iov_count; ++i) {
+                size_t end = iov[i].start_row + iov_row_count(&iov[i]);
+                if ((iov[i].status == SAFEROTP_IOV_STATUS_OK) && (iov[i].start_row <= window_end) && (window_end < end) && (window_end < window_limit)) {
+                    window_end = (end < window_limit) ? end : window_limit;
+                    extended = true;
+                }
+            }
+        } while (extended);
+
+        // 3. One raw access for the whole window (unreadable rows become 0xFFFFFFFFu)
+        //    When programming, the RMW mutex is held from this read until the window is written.
+        if (mode == IOV_SWEEP_PROGRAM) {
+            otp_rmw_lock();
+        }
+        (void)read_raw_rows_with_fallback(window_start, raw, window_end - window_start);
+        if (mode == IOV_SWEEP_PROGRAM) {
+            memcpy(to_write, raw, (window_end - window_start) * sizeof(uint32_t));
+        }
+
+        // 4. Each descriptor handles its units that lie entirely within the window, and were not already done
+        for (size_t i = 0; i < iov_count; ++i) {
+            if (iov[i].status != SAFEROTP_IOV_STATUS_OK) {
+                continue;
+            }
+            size_t start = iov[i].start_row;
+            size_t end = start + iov_row_count(&iov[i]);
+            size_t unit_rows = iov_rows_per_unit(&iov[i]);
+            size_t unit = (window_start <= start) ? 0u : ((window_start - start) + unit_rows - 1u) / unit_rows;
+            for (; ; ++unit) {
+                size_t unit_start = start + (unit * unit_rows);
+                size_t unit_end = unit_start + unit_rows;
+                if ((unit_end > window_end) || (unit_end > end)) {
+                    break;
+                }
+                if (unit_end <= cursor) {
+                    continue;
+                }
+                const uint32_t * unit_raw = &raw[unit_start - window_start];
+                if ((mode == IOV_SWEEP_CHECK_WRITES) && !iov_is_unit_writable(&iov[i], unit, unit_raw)) {
+                    iov[i].status = SAFEROTP_IOV_STATUS_WRITE_IMPOSSIBLE;
+                    break;
+                } else if ((mode == IOV_SWEEP_READ) && !iov_read_unit(&iov[i], unit, unit_raw)) {
+                    PRINT_ERROR("OTP_RW Error: iov[%zu]: failed to read rows 0x%03zx..0x%03zx\n", i, unit_start, unit_end - 1u);
+                    iov[i].status = SAFEROTP_IOV_STATUS_READ_FAILED;
+                    break;
+                } else if ((mode == IOV_SWEEP_VERIFY) && !iov_verify_unit(&iov[i], unit, unit_raw)) {
+                    PRINT_ERROR("OTP_RW Error: iov[%zu]: failed to verify rows 0x%03zx..0x%03zx\n", i, unit_start, unit_end - 1u);
+                    iov[i].status = SAFEROTP_IOV_STATUS_WRITE_FAILED;
+                    break;
+                } else if (mode == IOV_SWEEP_PROGRAM) {
+                    iov_plan_unit(&iov[i], unit, unit_raw, &to_write[unit_start - window_start]);
+                }
+            }
+        }
+
+        // 5. Program each contiguous run of changed rows in the window (across descriptors)
+        size_t r = 0;
+        while ((mode == IOV_SWEEP_PROGRAM) && (r < (window_end - window_start))) {
+            if (to_write[r] == raw[r]) {
+                ++r;
+                continue;
+            }
+            size_t run_start = r;
+            while ((r < (window_end - window_start)) && (to_write[r] != raw[r])) {
+                ++r;
+            }
+            if (!write_raw_wrapper(window_start + run_start, &to_write[run_start], (r - run_start) * sizeof(uint32_t))) {
+                // Ignored here ... the verification sweep reports which descriptors failed
+                PRINT_WARNING("OTP_RW WARN: Failed to write OTP rows %03zx..%03zx\n", window_start + run_start, window_start + r - 1u);
+            }
+        }
+        if (mode == IOV_SWEEP_PROGRAM) {
+            otp_rmw_unlock();
+        }
+        cursor = window_end;
+    }
+}
+// Writes and verifies one (already checked) descriptor, using the single-range write functions.
+static bool iov_write(const SAFEROTP_IOV* v) {
+    switch (v->encoding) {
+        case SAFEROTP_IOV_ENCODING_RAW: {
+            // Write the entire range at once, then verify a page at a time
+            uint32_t raw[NUM_OTP_PAGE_ROWS];
+            const uint32_t * p = (const uint32_t*)v->buffer;
+            size_t row_count = v->count_of_bytes / sizeof(uint32_t);
+            otp_rmw_lock();
+            bool written = write_raw_wrapper(v->start_row, p, v->count_of_bytes);
+            otp_rmw_unlock();
+            if (!written) {
+                PRINT_ERROR("OTP_RW Error: Failed to write raw OTP rows %03x..%03x\n", v->start_row, v->start_row + row_count - 1u);
+                return false;
+            }
+            for (size_t chunk = 0; chunk < row_count; chunk += NUM_OTP_PAGE_ROWS) {
+                size_t chunk_rows = row_count - chunk;
+                if (chunk_rows > NUM_OTP_PAGE_ROWS) {
+                    chunk_rows = NUM_OTP_PAGE_ROWS;
+                }
+                (void)read_raw_rows_with_fallback(v->start_row + chunk, raw, chunk_rows);
+                if (memcmp(raw, &p[chunk], chunk_rows * sizeof(uint32_t)) != 0) {
+                    PRINT_ERROR("OTP_RW Error: Failed to verify raw OTP rows %03x..%03x\n", v->start_row + chunk, v->start_row + chunk + chunk_rows - 1u);
+                    return false;
+                }
+            }
+            return true;
+        }
+        case SAFEROTP_IOV_ENCODING_ECC: {
+            return write_otp_ecc_data_planned(v->start_row, v->buffer, v->count_of_bytes);
+        }
+        case SAFEROTP_IOV_ENCODING_BYTE3X: {
+            return write_otp_byte_3x_data(v->start_row, (const uint8_t*)v->buffer, v->count_of_bytes);
+        }
+        case SAFEROTP_IOV_ENCODING_RBIT3: {
+            return write_otp_N_of_M_data(v->start_row, 2, 3, (const uint32_t*)v->buffer, v->count_of_bytes / sizeof(uint32_t));
+        }
+        case SAFEROTP_IOV_ENCODING_RBIT8: {
+            return write_otp_N_of_M_data(v->start_row, 3, 8, (const uint32_t*)v->buffer, v->count_of_bytes / sizeof(uint32_t));
+        }
+        default: {
+            return false;
+        }
+    }
+}
+static bool iov_all_ok(const SAFEROTP_IOV* iov, size_t iov_count) {
+    for (size_t i = 0; i < iov_count; ++i) {
+        if (iov[i].status != SAFEROTP_IOV_STATUS_OK) {
+            return false;
+        }
+    }
+    return true;
+}
+static void iov_mark_not_attempted(SAFEROTP_IOV* iov, size_t iov_count) {
+    for (size_t i = 0; i < iov_count; ++i) {
+        if (iov[i].status == SAFEROTP_IOV_STATUS_OK) {
+            iov[i].status = SAFEROTP_IOV_STATUS_NOT_ATTEMPTED;
+        }
+    }
+}
+#pragma endregion // Scatter / gather (vectored) reads and writes
+
+#pragma region    // Per-row status (`_ext`) bulk functions
+// Unlike the other bulk functions, these never stop at the first bad row.
+// The whole range is always processed, and the outcome for each row is
+// reported (SAFEROTP_ROW_STATUS), so callers can retry / repair only those rows.
+
+static bool is_row_status_ok(uint8_t status) {
+    return (status == SAFEROTP_ROW_STATUS_OK) || (status == SAFEROTP_ROW_STATUS_CORRECTED);
+}
+// Row status for a raw value that was read as ECC data (0xFFFFFFFFu if unreadable).
+static uint8_t ecc_row_status(uint32_t raw, uint32_t* out_decoded) {
+    SAFEROTP_ECC_DECODE_DETAILS details;
+    if (raw == 0xFFFFFFFFu) {
+        *out_decoded = 0xFFFFFFFFu;
+        return SAFEROTP_ROW_STATUS_IO_ERROR;
+    }
+    *out_decoded = saferotp_decode_raw_with_details(raw, &details);
+    if (details.status == SAFEROTP_ECC_ROW_STATUS_CLEAN) {
+        return SAFEROTP_ROW_STATUS_OK;
+    } else if (details.status == SAFEROTP_ECC_ROW_STATUS_CORRECTED) {
+        return SAFEROTP_ROW_STATUS_CORRECTED;
+    }
+    return SAFEROTP_ROW_STATUS_UNDECODABLE;
+}
+static bool read_otp_ecc_data_ext(uint16_t start_row, void* out_data, size_t count_of_bytes, uint8_t* out_row_status) {
+    size_t row_count = (count_of_bytes + 1u) / 2u;
+    if (row_count == 0u) {
+        return true;
+    }
+    if (!is_valid_otp_range_raw(start_row, row_count * sizeof(uint32_t))) {
+        PRINT_ERROR("OTP_RW Error: Invalid (start row / byte count): 0x%03x %zu\n", start_row, count_of_bytes);
+        return false;
+    }
+    uint8_t * b = (uint8_t*)out_data; // byte-based pointer, as only one byte of the final row may be valid
+    uint32_t raw[NUM_OTP_PAGE_ROWS];
+    bool result = true;
+    for (size_t chunk = 0; chunk < row_count; chunk += NUM_OTP_PAGE_ROWS) {
+        size_t chunk_rows = row_count - chunk;
+        if (chunk_rows > NUM_OTP_PAGE_ROWS) {
+            chunk_rows = NUM_OTP_PAGE_ROWS;
+        }
+        (void)read_raw_rows_with_fallback(start_row + chunk, raw, chunk_rows);
+        for (size_t i = 0; i < chunk_rows; ++i) {
+            size_t byte_index = (chunk + i) * 2u;
+            uint32_t decoded;
+            uint8_t status = ecc_row_status(raw[i], &decoded);
+            out_row_status[chunk + i] = status;
+            if (!is_row_status_ok(status)) {
+                PRINT_ERROR("OTP_RW Error: Failed to read / decode OTP row %03x: Result 0x%08x\n", start_row + chunk + i, decoded);
+                decoded = 0xFFFFu;
+                result = false;
+            }
+            b[byte_index] = (uint8_t)decoded;
+            if ((byte_index + 1u) < count_of_bytes) {
+                b[byte_index + 1u] = (uint8_t)(decoded >> 8);
+            }
+        }
+    }
+    return result;
+}
+static bool read_otp_raw_data_ext(uint16_t start_row, void* out_data, size_t count_of_bytes, uint8_t* out_row_status) {
+    if ((count_of_bytes == 0u) || !is_valid_otp_range_raw(start_row, count_of_bytes)) {
+        PRINT_ERROR("OTP_RW Error: Invalid (start row / raw byte count): 0x%03x %zu\n", start_row, count_of_bytes);
+        return false;
+    }
+    size_t row_count = count_of_bytes / sizeof(uint32_t);
+    uint32_t * out = (uint32_t*)out_data;
+    bool result = read_raw_rows_with_fallback(start_row, out, row_count);
+    for (size_t i = 0; i < row_count; ++i) {
+        out_row_status[i] = (out[i] == 0xFFFFFFFFu) ? SAFEROTP_ROW_STATUS_IO_ERROR : SAFEROTP_ROW_STATUS_OK;
+    }
+    return result;
+}
+// Writes every row of the range that can be written, even if other rows cannot.
+static bool write_otp_ecc_data_ext(uint16_t start_row, const void* data, size_t count_of_bytes, uint8_t* out_row_status) {
+    size_t row_count = (count_of_bytes + 1u) / 2u;
+    if (row_count == 0u) {
+        return true;
+    }
+    if (!is_valid_otp_range_raw(start_row, row_count * sizeof(uint32_t))) {
+        PRINT_ERROR("OTP_RW Error: Invalid (start row / byte count): 0x%03x %zu\n", start_row, count_of_bytes);
+        return false;
+    }
+    uint16_t values[xPLANNED_ROWS_PER_CHUNK];
+    uint32_t raw[xPLANNED_ROWS_PER_CHUNK];
+    SAFEROTP_ECC_WRITE_PLAN plan[xPLANNED_ROWS_PER_CHUNK];
+    bool result = true;
+
+    for (size_t chunk = 0; chunk < row_count; chunk += xPLANNED_ROWS_PER_CHUNK) {
+        size_t chunk_rows = row_count - chunk;
+        if (chunk_rows > xPLANNED_ROWS_PER_CHUNK) {
+            chunk_rows = xPLANNED_ROWS_PER_CHUNK;
+        }
+        uint16_t chunk_start_row = start_row + chunk;
+        uint8_t * status = &out_row_status[chunk];
+
+        // 1. Read and plan the chunk.  Rows that cannot be written are reported, and skipped.
+        gather_ecc_row_values(data, count_of_bytes, chunk, chunk_rows, values);
+        otp_rmw_lock();
+        (void)read_raw_rows_with_fallback(chunk_start_row, raw, chunk_rows);
+        saferotp_plan_ecc_writes(raw, values, plan, chunk_rows);
+        for (size_t i = 0; i < chunk_rows; ++i) {
+            status[i] = SAFEROTP_ROW_STATUS_OK;
+            if (plan[i].action == SAFEROTP_ECC_WRITE_PLAN_IMPOSSIBLE) {
+                PRINT_ERROR("OTP_RW Error: Cannot write ECC OTP row %03x with data 0x%04x (existing 0x%06x)\n", chunk_start_row + i, values[i], raw[i]);
+                status[i] = (raw[i] == 0xFFFFFFFFu) ? SAFEROTP_ROW_STATUS_IO_ERROR : SAFEROTP_ROW_STATUS_WRITE_INCOMPATIBLE;
+            }
+        }
+
+        // 2. Program each contiguous run of rows that need writing.
+        //    If a run fails, retry its rows individually, to find which rows failed.
+        size_t i = 0;
+        while (i < chunk_rows) {
+            if ((plan[i].action != SAFEROTP_ECC_WRITE_PLAN_WRITE) && (plan[i].action != SAFEROTP_ECC_WRITE_PLAN_WRITE_DEGRADED)) {
+                ++i;
+                continue;
+            }
+            size_t run_start = i;
+            while ((i < chunk_rows) && ((plan[i].action == SAFEROTP_ECC_WRITE_PLAN_WRITE) || (plan[i].action == SAFEROTP_ECC_WRITE_PLAN_WRITE_DEGRADED))) {
+                raw[i] = plan[i].raw_to_write;
+                ++i;
+            }
+            if (write_raw_wrapper(chunk_start_row + run_start, &raw[run_start], (i - run_start) * sizeof(uint32_t))) {
+                continue;
+            }
+            for (size_t j = run_start; j < i; ++j) {
+                if (!write_raw_wrapper(chunk_start_row + j, &raw[j], sizeof(uint32_t))) {
+                    PRINT_ERROR("OTP_RW Error: Failed to write ECC OTP row %03x\n", chunk_start_row + j);
+                    status[j] = SAFEROTP_ROW_STATUS_IO_ERROR;
+                }
+            }
+        }
+
+        // 3. Verify the entire chunk with a single bulk read
+        (void)read_raw_rows_with_fallback(chunk_start_row, raw, chunk_rows);
+        otp_rmw_unlock();
+        for (size_t j = 0; j < chunk_rows; ++j) {
+            if (status[j] != SAFEROTP_ROW_STATUS_OK) {
+                result = false;
+                continue;
+            }
+            uint32_t decoded;
+            status[j] = ecc_row_status(raw[j], &decoded);
+            if (is_row_status_ok(status[j]) && (decoded != values[j])) {
+                status[j] = SAFEROTP_ROW_STATUS_IO_ERROR; // the write did not take effect
+            }
+            if (!is_row_status_ok(status[j])) {
+                PRINT_ERROR("OTP_RW Error: Failed to verify ECC OTP row %03x has data 0x%04x (result 0x%08x)\n", chunk_start_row + j, values[j], decoded);
+                result = false;
+            }
+        }
+    }
+    return result;
+}
+#pragma endregion // Per-row status (`_ext`) bulk functions
+
+#pragma region    // Asynchronous (queued) writes
+// Programming fuses is slow, so saferotp_async_write() only queues the request,
+// and each call to saferotp_poll() does one bounded step of the request at the
+// head of the queue:
+//   * the first step checks the entire request (reads only), so that a request
+//     that cannot be written completes before anything is burned;
+//   * each later step programs, then verifies, at most SAFEROTP_ASYNC_ROWS_PER_POLL rows.
+// The queue is a ring with a single consumer: requests may be submitted from either
+// core (or from a completion callback), serialized by a short spin lock, while one core
+// (e.g., core1) calls saferotp_poll().
+#ifndef SAFEROTP_ASYNC_ROWS_PER_POLL
+    #define SAFEROTP_ASYNC_ROWS_PER_POLL 8u
+#endif
+static_assert(SAFEROTP_ASYNC_ROWS_PER_POLL >= MAX_M_VALUE, "each step must program at least one RBIT8 group");
+static_assert(SAFEROTP_ASYNC_ROWS_PER_POLL <= NUM_OTP_PAGE_ROWS, "each step is limited to one page of rows");
+static_assert(SAFEROTP_ASYNC_QUEUE_DEPTH <= 128u, "queue indices are uint8_t");
+static_assert((SAFEROTP_ASYNC_QUEUE_DEPTH & (SAFEROTP_ASYNC_QUEUE_DEPTH - 1u)) == 0u, "uint8_t queue indices wrap correctly only for a power of two");
+
+typedef struct _ASYNC_REQUEST {
+    SAFEROTP_IOV            iov;
+    SAFEROTP_ASYNC_CALLBACK callback;
+    void*                   context;
+    SAFEROTP_ASYNC_HANDLE   handle;
+    uint16_t                next_unit; // first unit not yet programmed
+    bool                    checked;
+} ASYNC_REQUEST;
+static ASYNC_REQUEST g_async_queue[SAFEROTP_ASYNC_QUEUE_DEPTH];
+static uint8_t g_async_head = 0u; // only written by saferotp_poll(), holding g_otp_rmw_mutex and g_async_polling
+static uint8_t g_async_tail = 0u; // only written by saferotp_async_write(), holding g_otp_async_lock
+static SAFEROTP_ASYNC_HANDLE g_async_last_handle = SAFEROTP_ASYNC_INVALID_HANDLE;
+static bool g_async_polling = false; // set while saferotp_poll() steps the request at the head
+
+static size_t iov_bytes_per_unit(const SAFEROTP_IOV* v) {
+    if (v->encoding == SAFEROTP_IOV_ENCODING_ECC) {
+        return 2u;
+    } else if (v->encoding == SAFEROTP_IOV_ENCODING_BYTE3X) {
+        return 1u;
+    }
+    return sizeof(uint32_t);
+}
+// Descriptor for units [first_unit .. first_unit + unit_count) of `v` (truncated to the end of `v`,
+// so a slice starting at or past the end of `v` is empty).
+static SAFEROTP_IOV iov_slice(const SAFEROTP_IOV* v, size_t first_unit, size_t unit_count) {
+    size_t offset = first_unit * iov_bytes_per_unit(v);
+    size_t bytes = unit_count * iov_bytes_per_unit(v);
+    if (offset >= v->count_of_bytes) {
+        offset = v->count_of_bytes;
+        bytes = 0u;
+    } else if (bytes > (v->count_of_bytes - offset)) {
+        bytes = v->count_of_bytes - offset;
+    }
+    SAFEROTP_IOV slice = *v;
+    slice.buffer = &((uint8_t*)v->buffer)[offset];
+    slice.count_of_bytes = bytes;
+    slice.start_row = v->start_row + (first_unit * iov_rows_per_unit(v));
+    return slice;
+}
+// Does one bounded step of the request; returns true once the request is complete (see its `iov.status`).
+static bool async_step(ASYNC_REQUEST* r) {
+    if (!r->checked) {
+        iov_sweep(&r->iov, 1u, IOV_SWEEP_CHECK_WRITES);
+        r->checked = true;
+        return r->iov.status != SAFEROTP_IOV_STATUS_OK;
+    }
+    size_t unit_count = (r->iov.count_of_bytes + iov_bytes_per_unit(&r->iov) - 1u) / iov_bytes_per_unit(&r->iov);
+    if (r->next_unit >= unit_count) {
+        return true; // nothing left to program (never burn past the end of the request)
+    }
+    SAFEROTP_IOV slice = iov_slice(&r->iov, r->next_unit, SAFEROTP_ASYNC_ROWS_PER_POLL / iov_rows_per_unit(&r->iov));
+    iov_sweep(&slice, 1u, IOV_SWEEP_PROGRAM);
+    iov_sweep(&slice, 1u, IOV_SWEEP_VERIFY);
+    if (slice.status != SAFEROTP_IOV_STATUS_OK) {
+        r->iov.status = slice.status;
+        return true;
+    }
+    r->next_unit += SAFEROTP_ASYNC_ROWS_PER_POLL / iov_rows_per_unit(&r->iov);
+    return r->next_unit >= unit_count;
+}
+#pragma endregion // Asynchronous (queued) writes
+
+/// All code above this point are the static helper functions / implementation details.
+/// Only the below are the public API functions.
+
+bool saferotp_virtualization_init_pages(uint64_t ignored_pages_mask) {
+    virt_initialize(ignored_pages_mask);
+    return true;
+}
+bool saferotp_virtualization_restore(uint16_t starting_row, const void* buffer, size_t buffer_size) {
+    return virt_override_restore(starting_row, buffer, buffer_size);
+}
+bool saferotp_virtualization_save(uint16_t starting_row, void* buffer, size_t buffer_size) {
     return virt_override_save(starting_row, buffer, buffer_size);
 }
+void saferotp_flush_raw_row_cache(void) {
+    cache_flush();
+}
+uint8_t saferotp_lock_acquire(uint32_t timeout_us) {
+    return otp_lock_acquire(timeout_us);
+}
+bool saferotp_lock_release(void) {
+    return otp_lock_release();
+}
+uint8_t saferotp_lock_last_status(void) {
+    return otp_lock_last_status();
+}
 
 // NOTE: On failure, the state of the OTP row(s) is UNDEFINED.
 //       For example, some rows may have been written, while other rows failed to be written.
@@ -758,23 +2496,38 @@ bool saferotp_virtualization_save(uint16_t starting_row, void* buffer, size_t bu
 
 
 bool saferotp_write_single_value_raw_unsafe(uint16_t row, uint32_t new_value) {
-    return write_single_otp_raw_row(row, new_value);
+    otp_rmw_lock();
+    bool result = write_single_otp_raw_row(row, new_value);
+    otp_rmw_unlock();
+    return result;
 }
 bool saferotp_read_single_value_raw_unsafe(uint16_t row, uint32_t* out_data) {
     return read_raw_wrapper(row, out_data, sizeof(uint32_t));
 }
 bool saferotp_write_single_value_ecc(uint16_t row, uint16_t new_value) {
-    return write_single_otp_ecc_row(row, new_value);
+    otp_rmw_lock();
+    bool result = write_single_otp_ecc_row(row, new_value);
+    otp_rmw_unlock();
+    return result;
 }
 bool saferotp_read_single_value_ecc(uint16_t row, uint16_t* out_data) {
     return read_single_otp_ecc_row(row, out_data);
 }
 bool saferotp_write_single_value_byte3x(uint16_t row, uint8_t new_value) {
-    return write_otp_byte_3x(row, new_value);
+    otp_rmw_lock();
+    bool result = write_otp_byte_3x(row, new_value);
+    otp_rmw_unlock();
+    return result;
 }
 bool saferotp_read_single_value_byte3x(uint16_t row, uint8_t* out_data) {
     return read_otp_byte_3x(row, out_data);
 }
+bool saferotp_write_data_byte3x(uint16_t start_row, const void* data, size_t count_of_bytes) {
+    return write_otp_byte_3x_data(start_row, (const uint8_t*)data, count_of_bytes);
+}
+bool saferotp_read_data_byte3x(uint16_t start_row, void* out_data, size_t count_of_bytes) {
+    return read_otp_byte_3x_data(start_row, (uint8_t*)out_data, count_of_bytes);
+}
 bool saferotp_write_single_value_rbit3(uint16_t start_row, uint32_t new_value) {
     return write_single_otp_value_N_of_M(start_row, 2, 3, new_value);
 }
@@ -787,63 +2540,327 @@ bool saferotp_write_single_value_rbit8(uint16_t start_row, uint32_t new_value) {
 bool saferotp_read_single_value_rbit8(uint16_t start_row, uint32_t* out_data) {
     return read_single_otp_value_N_of_M(start_row, 3, 8, out_data);
 }
+bool saferotp_write_data_rbit3(uint16_t start_row, const void* data, size_t count_of_bytes) {
+    if ((count_of_bytes == 0u) || ((count_of_bytes % sizeof(uint32_t)) != 0u)) {
+        return false;
+    }
+    return write_otp_N_of_M_data(start_row, 2, 3, (const uint32_t*)data, count_of_bytes / sizeof(uint32_t));
+}
+bool saferotp_read_data_rbit3(uint16_t start_row, void* out_data, size_t count_of_bytes) {
+    if ((count_of_bytes == 0u) || ((count_of_bytes % sizeof(uint32_t)) != 0u)) {
+        return false;
+    }
+    return read_otp_N_of_M_data(start_row, 2, 3, (uint32_t*)out_data, count_of_bytes / sizeof(uint32_t));
+}
+bool saferotp_write_data_rbit8(uint16_t start_row, const void* data, size_t count_of_bytes) {
+    if ((count_of_bytes == 0u) || ((count_of_bytes % sizeof(uint32_t)) != 0u)) {
+        return false;
+    }
+    return write_otp_N_of_M_data(start_row, 3, 8, (const uint32_t*)data, count_of_bytes / sizeof(uint32_t));
+}
+bool saferotp_read_data_rbit8(uint16_t start_row, void* out_data, size_t count_of_bytes) {
+    if ((count_of_bytes == 0u) || ((count_of_bytes % sizeof(uint32_t)) != 0u)) {
+        return false;
+    }
+    return read_otp_N_of_M_data(start_row, 3, 8, (uint32_t*)out_data, count_of_bytes / sizeof(uint32_t));
+}
 
 // Arbitrary buffer size support functions ...
 bool saferotp_write_data_ecc(uint16_t start_row, const void* data, size_t count_of_bytes) {
+    return write_otp_ecc_data_planned(start_row, data, count_of_bytes);
+}
+bool saferotp_read_data_ecc(uint16_t start_row, void* out_data, size_t count_of_bytes) {
+    if (count_of_bytes >= (0x1000*2)) { // OTP rows from 0x000u to 0xFFFu, so max 0x1000*2 bytes
+        return false;
+    }
 
-    // write / verify one OTP row at a time
-    size_t loop_count = count_of_bytes / 2u;
-    bool require_buffering_last_row = (count_of_bytes & 1u);
+    // Fetch the raw rows a page at a time (one bootrom call per page, unless a row
+    // fails to read), then decode the whole chunk in one pass.
+    // Same results as reading one row at a time: stops at the first row that fails
+    // to read or decode, which (if a full row) is set to 0xFFFF in the buffer.
+    enum { ROWS_PER_CHUNK = NUM_OTP_PAGE_ROWS };
+    size_t row_count = (count_of_bytes + 1u) / 2u;
+    uint8_t * b = (uint8_t*)out_data; // byte-based pointer, as only one byte of the final row may be valid
+    uint32_t raw[ROWS_PER_CHUNK];
 
-    // Write full-sized rows first
-    for (size_t i = 0; i < loop_count; ++i) {
-        uint16_t tmp = ((const uint16_t*)data)[i];
-        if (!saferotp_write_single_value_ecc(start_row + i, tmp)) {
-            return false;
+    for (size_t chunk = 0; chunk < row_count; chunk += ROWS_PER_CHUNK) {
+        size_t chunk_rows = row_count - chunk;
+        if (chunk_rows > ROWS_PER_CHUNK) {
+            chunk_rows = ROWS_PER_CHUNK;
         }
-    }
-    
-    // Write any final partial-row data
-    if (require_buffering_last_row) {
-        // Read the single byte ... do NOT read as uint16_t as additional byte may not be valid readable memory
-        // and use the local stack uint16_t for the actual write operation.
-        uint16_t tmp = ((const uint8_t*)data)[count_of_bytes-1];
-        if (!saferotp_write_single_value_ecc(start_row + loop_count, tmp)) {
-            return false;
+        (void)read_raw_rows_with_fallback(start_row + chunk, raw, chunk_rows);
+        saferotp_decode_raw_batch(raw, raw, chunk_rows);
+
+        for (size_t i = 0; i < chunk_rows; ++i) {
+            size_t byte_index = (chunk + i) * 2u;
+            bool full_row = (byte_index + 1u) < count_of_bytes;
+            uint32_t decode_result = raw[i];
+            if ((decode_result & 0xFF000000u) != 0u) {
+                PRINT_ERROR("OTP_RW Error: Failed to decode OTP row %03x: Result 0x%08x\n", start_row + chunk + i, decode_result);
+                if (full_row) {
+                    b[byte_index + 0u] = 0xFFu;
+                    b[byte_index + 1u] = 0xFFu;
+                }
+                return false;
+            }
+            b[byte_index] = (uint8_t)decode_result;
+            if (full_row) {
+                b[byte_index + 1u] = (uint8_t)(decode_result >> 8);
+            }
         }
     }
     return true;
 }
-bool saferotp_read_data_ecc(uint16_t start_row, void* out_data, size_t count_of_bytes) {
-    if (count_of_bytes >= (0x1000*2)) { // OTP rows from 0x000u to 0xFFFu, so max 0x1000*2 bytes
+bool saferotp_read_data_ecc_with_details(uint16_t start_row, SAFEROTP_ECC_DECODE_DETAILS* out_details, size_t row_count) {
+    if (!is_valid_otp_range_raw(start_row, row_count * sizeof(uint32_t))) {
+        PRINT_ERROR("OTP_RW Error: Invalid (start row / row count): 0x%03x %zu\n", start_row, row_count);
         return false;
     }
+    enum { ROWS_PER_CHUNK = NUM_OTP_PAGE_ROWS };
+    uint32_t raw[ROWS_PER_CHUNK];
+    bool result = true;
 
-    // read one OTP row at a time
-    size_t loop_count = count_of_bytes / 2u;
-    bool requires_buffering_last_row = (count_of_bytes & 1u);
-
-    // Read full-sized rows first
-    for (size_t i = 0; i < loop_count; ++i) {
-        uint16_t * b = ((uint16_t*)out_data) + i; // pointer arithmetic
-        if (!saferotp_read_single_value_ecc(start_row + i, b)) {
-            return false;
+    for (size_t chunk = 0; chunk < row_count; chunk += ROWS_PER_CHUNK) {
+        size_t chunk_rows = row_count - chunk;
+        if (chunk_rows > ROWS_PER_CHUNK) {
+            chunk_rows = ROWS_PER_CHUNK;
+        }
+        if (!read_raw_rows_with_fallback(start_row + chunk, raw, chunk_rows)) {
+            result = false;
+        }
+        SAFEROTP_ECC_DECODE_DETAILS * d = &out_details[chunk];
+        saferotp_decode_raw_batch_with_details(raw, d, chunk_rows);
+
+        for (size_t i = 0; i < chunk_rows; ++i) {
+            if (raw[i] == 0xFFFFFFFFu) {
+                // Failed to read this row
+                d[i].result        = 0xFFFFFFFFu;
+                d[i].flipped_bit   = -1;
+                d[i].status        = SAFEROTP_ECC_ROW_STATUS_READ_FAILED;
+                d[i].brbp_inverted = 0u;
+                d[i].reserved      = 0u;
+            } else if ((d[i].result & 0xFF000000u) != 0u) {
+                PRINT_ERROR("OTP_RW Error: Failed to decode OTP row %03x value 0x%06x: Result 0x%08x\n", start_row + chunk + i, raw[i], d[i].result);
+                result = false;
+            }
         }
     }
+    return result;
+}
 
-    // Read any final partial-row data
-    if (requires_buffering_last_row) {
-        uint16_t tmp = 0xFFFFu;
-        if (!saferotp_read_single_value_ecc(start_row + loop_count, &tmp)) {
+bool saferotp_read_key_ecc(uint16_t start_row, void* out_key, size_t count_of_bytes) {
+    enum { MAX_KEY_ROWS = 64u };
+    static_assert(MAX_KEY_ROWS % 32u == 0u, "decoded 32 rows at a time");
+    size_t row_count = count_of_bytes / 2u;
+    if ((count_of_bytes == 0u) || (count_of_bytes & 1u) || (row_count > MAX_KEY_ROWS)) {
+        PRINT_ERROR("OTP_RW Error: Key read requires an even number of bytes, at most %d (got %zu)\n", MAX_KEY_ROWS*2, count_of_bytes);
+        return false;
+    }
+
+    // 1. Fetch the entire key range with a single raw access, bypassing the raw row cache.
+    //    Rows beyond the key (padding to a multiple of 32 rows) are zero, which always decodes.
+    uint32_t raw[MAX_KEY_ROWS] = {0u};
+    bool read_ok = read_raw_uncached_wrapper(start_row, raw, row_count * sizeof(uint32_t));
+
+    // 2. Decode with the bit-sliced decoder, which has no data-dependent branches or table lookups.
+    //    Every block is decoded, even if the read failed, so timing does not depend on the data.
+    uint32_t any_error = 0u;
+    for (size_t block = 0u; block < row_count; block += 32u) {
+        saferotp_decode_raw_x32(&raw[block], &raw[block]);
+    }
+    uint8_t * b = (uint8_t*)out_key;
+    for (size_t i = 0u; i < row_count; ++i) {
+        any_error |= raw[i];
+        b[2u*i + 0u] = (uint8_t)(raw[i] >> 0);
+        b[2u*i + 1u] = (uint8_t)(raw[i] >> 8);
+    }
+
+    // 3. Single aggregate status ... on any failure, never return partial key material.
+    //    The decoded key is never left on the stack.
+    wipe_secret(raw, sizeof(raw));
+    bool result = read_ok && ((any_error & 0xFF000000u) == 0u);
+    if (!result) {
+        memset(out_key, 0, count_of_bytes);
+        PRINT_ERROR("OTP_RW Error: Failed to read key from OTP rows %03x (0x%zx rows)\n", start_row, row_count);
+    }
+    return result;
+}
+
+bool saferotp_write_data_ecc_rs(uint16_t start_row, const void* data, size_t count_of_bytes, uint8_t parity_rows) {
+    return write_otp_ecc_rs_blob(start_row, data, count_of_bytes, parity_rows);
+}
+bool saferotp_read_data_ecc_rs(uint16_t start_row, void* out_data, size_t count_of_bytes, uint8_t parity_rows) {
+    return read_otp_ecc_rs_blob(start_row, out_data, count_of_bytes, parity_rows);
+}
+
+bool saferotp_readv(SAFEROTP_IOV* iov, size_t iov_count) {
+    (void)iov_validate(iov, iov_count, false); // invalid descriptors are skipped
+    iov_sweep(iov, iov_count, IOV_SWEEP_READ);
+    return iov_all_ok(iov, iov_count);
+}
+bool saferotp_writev(SAFEROTP_IOV* iov, size_t iov_count) {
+    // The RMW mutex is held from the check until the last descriptor is verified, so no
+    // other write can change the rows after they were checked (iov_write() nests inside it)
+    otp_rmw_lock();
+    // 1. Check every descriptor before anything is written
+    if (iov_validate(iov, iov_count, true)) {
+        iov_sweep(iov, iov_count, IOV_SWEEP_CHECK_WRITES);
+    }
+    if (!iov_all_ok(iov, iov_count)) {
+        otp_rmw_unlock();
+        iov_mark_not_attempted(iov, iov_count);
+        return false;
+    }
+    // 2. Write and verify each descriptor
+    for (size_t i = 0; i < iov_count; ++i) {
+        if (!iov_write(&iov[i])) {
+            otp_rmw_unlock();
+            iov[i].status = SAFEROTP_IOV_STATUS_WRITE_FAILED;
+            iov_mark_not_attempted(&iov[i + 1u], iov_count - i - 1u);
             return false;
         }
-        // update the last single byte of the buffer
-        // ensure to use byte-based pointer, as only one buffer byte is ensured to be valid
-        uint8_t * b = ((uint8_t*)out_data) + count_of_bytes - 1u;
-        *b = (tmp & 0xFFu);
     }
+    otp_rmw_unlock();
+    return true;
+}
+
+void saferotp_txn_begin(SAFEROTP_TXN* txn) {
+    memset(txn, 0, sizeof(SAFEROTP_TXN));
+}
+bool saferotp_txn_add(SAFEROTP_TXN* txn, uint8_t encoding, uint16_t start_row, const void* data, size_t count_of_bytes) {
+    if (txn->op_count >= SAFEROTP_TXN_MAX_OPS) {
+        PRINT_ERROR("OTP_RW Error: transaction already has %d operations\n", SAFEROTP_TXN_MAX_OPS);
+        txn->add_failed = true;
+        return false;
+    }
+    SAFEROTP_IOV * v = &txn->ops[txn->op_count];
+    v->buffer = (void*)data; // only read by commit
+    v->count_of_bytes = count_of_bytes;
+    v->start_row = start_row;
+    v->encoding = encoding;
+    v->status = SAFEROTP_IOV_STATUS_OK;
+    size_t rows = iov_row_count(v);
+    if ((rows == 0u) || !is_valid_otp_range_raw(start_row, rows * sizeof(uint32_t))) {
+        PRINT_ERROR("OTP_RW Error: transaction: invalid encoding %d / start row 0x%03x / byte count %zu\n", encoding, start_row, count_of_bytes);
+        txn->add_failed = true; // the whole transaction must fail, not just this operation
+        return false;
+    }
+    ++(txn->op_count);
     return true;
 }
+bool saferotp_txn_commit(SAFEROTP_TXN* txn) {
+    if (txn->add_failed) {
+        PRINT_ERROR("OTP_RW Error: transaction not committed, as adding an operation failed\n");
+        iov_mark_not_attempted(txn->ops, txn->op_count);
+        return false;
+    }
+    // The RMW mutex is held from the check until the verify, so no other write can change
+    // the rows after they were checked (the program sweep's per-window locks nest inside it)
+    otp_rmw_lock();
+    // 1. Check every operation against one sweep of the affected rows, before anything is written
+    if (iov_validate(txn->ops, txn->op_count, true)) {
+        iov_sweep(txn->ops, txn->op_count, IOV_SWEEP_CHECK_WRITES);
+    }
+    if (!iov_all_ok(txn->ops, txn->op_count)) {
+        otp_rmw_unlock();
+        iov_mark_not_attempted(txn->ops, txn->op_count);
+        return false;
+    }
+    // 2. Program all the operations in row order, coalescing runs of rows across operations
+    iov_sweep(txn->ops, txn->op_count, IOV_SWEEP_PROGRAM);
+    // 3. Verify all the operations with a single sweep
+    iov_sweep(txn->ops, txn->op_count, IOV_SWEEP_VERIFY);
+    otp_rmw_unlock();
+    return iov_all_ok(txn->ops, txn->op_count);
+}
+
+SAFEROTP_ASYNC_HANDLE saferotp_async_write(uint8_t encoding, uint16_t start_row, const void* data, size_t count_of_bytes, SAFEROTP_ASYNC_CALLBACK callback, void* context) {
+    // Validate before taking the lock, which is held with interrupts disabled
+    SAFEROTP_IOV iov = { 0 };
+    iov.buffer = (void*)data; // only read
+    iov.count_of_bytes = count_of_bytes;
+    iov.start_row = start_row;
+    iov.encoding = encoding;
+    if (!iov_validate(&iov, 1u, false)) {
+        return SAFEROTP_ASYNC_INVALID_HANDLE;
+    }
+    otp_locks_init();
+    uint32_t saved_irq = spin_lock_blocking(g_otp_async_lock);
+    uint8_t tail = g_async_tail;
+    if ((uint8_t)(tail - __atomic_load_n(&g_async_head, __ATOMIC_ACQUIRE)) >= SAFEROTP_ASYNC_QUEUE_DEPTH) {
+        spin_unlock(g_otp_async_lock, saved_irq);
+        PRINT_ERROR("OTP_RW Error: async write queue is full\n");
+        return SAFEROTP_ASYNC_INVALID_HANDLE;
+    }
+    ASYNC_REQUEST * r = &g_async_queue[tail % SAFEROTP_ASYNC_QUEUE_DEPTH];
+    memset(r, 0, sizeof(ASYNC_REQUEST));
+    r->iov = iov;
+    r->callback = callback;
+    r->context = context;
+    if (++g_async_last_handle == SAFEROTP_ASYNC_INVALID_HANDLE) {
+        ++g_async_last_handle;
+    }
+    SAFEROTP_ASYNC_HANDLE handle = g_async_last_handle;
+    r->handle = handle;
+    __atomic_store_n(&g_async_tail, (uint8_t)(tail + 1u), __ATOMIC_RELEASE); // publish the request
+    spin_unlock(g_otp_async_lock, saved_irq);
+    return handle;
+}
+bool saferotp_poll(void) {
+    if (__atomic_load_n(&g_async_head, __ATOMIC_RELAXED) == __atomic_load_n(&g_async_tail, __ATOMIC_ACQUIRE)) {
+        return false; // nothing queued
+    }
+    // Takes only the RMW mutex (recursive, so this also works while the caller holds
+    // saferotp_lock_acquire()).  Never waits: if the other core is writing, the step
+    // is left for a later poll.
+    if (!recursive_mutex_try_enter(&g_otp_rmw_mutex, NULL)) {
+        return true;
+    }
+    // Two tasks that share an owner id both get the (recursive) mutex, so the step is also
+    // claimed with a flag.  Whoever holds it is the only one to step or retire a request.
+    if (__atomic_exchange_n(&g_async_polling, true, __ATOMIC_ACQUIRE)) {
+        recursive_mutex_exit(&g_otp_rmw_mutex);
+        return true;
+    }
+    // Re-load the indices: another poll may have retired the request before the claim
+    uint8_t head = __atomic_load_n(&g_async_head, __ATOMIC_RELAXED);
+    if (head == __atomic_load_n(&g_async_tail, __ATOMIC_ACQUIRE)) {
+        __atomic_store_n(&g_async_polling, false, __ATOMIC_RELEASE);
+        recursive_mutex_exit(&g_otp_rmw_mutex);
+        return false;
+    }
+    ASYNC_REQUEST * r = &g_async_queue[head % SAFEROTP_ASYNC_QUEUE_DEPTH];
+    bool completed = async_step(r);
+    SAFEROTP_ASYNC_CALLBACK callback = NULL;
+    void * context = NULL;
+    SAFEROTP_ASYNC_HANDLE handle = SAFEROTP_ASYNC_INVALID_HANDLE;
+    uint8_t status = SAFEROTP_IOV_STATUS_OK;
+    if (completed) {
+        // Retire the request while still claimed, and release its slot before the
+        // callback, so the callback may queue another request
+        callback = r->callback;
+        context = r->context;
+        handle = r->handle;
+        status = r->iov.status;
+        __atomic_store_n(&g_async_head, (uint8_t)(head + 1u), __ATOMIC_RELEASE);
+    }
+    __atomic_store_n(&g_async_polling, false, __ATOMIC_RELEASE);
+    recursive_mutex_exit(&g_otp_rmw_mutex);
+    if (callback != NULL) {
+        callback(handle, status, context);
+    }
+    return __atomic_load_n(&g_async_head, __ATOMIC_RELAXED) != __atomic_load_n(&g_async_tail, __ATOMIC_ACQUIRE);
+}
+
+bool saferotp_read_data_ecc_ext(uint16_t start_row, void* out_data, size_t count_of_bytes, uint8_t* out_row_status) {
+    return read_otp_ecc_data_ext(start_row, out_data, count_of_bytes, out_row_status);
+}
+bool saferotp_write_data_ecc_ext(uint16_t start_row, const void* data, size_t count_of_bytes, uint8_t* out_row_status) {
+    return write_otp_ecc_data_ext(start_row, data, count_of_bytes, out_row_status);
+}
+bool saferotp_read_data_raw_unsafe_ext(uint16_t start_row, void* out_data, size_t count_of_bytes, uint8_t* out_row_status) {
+    return read_otp_raw_data_ext(start_row, out_data, count_of_bytes, out_row_status);
+}
 
 bool saferotp_read_data_raw_unsafe(uint16_t start_row, void* out_data, size_t count_of_bytes) {
     if (count_of_bytes == 0u) {
@@ -874,7 +2891,10 @@ bool saferotp_write_data_raw_unsafe(uint16_t start_row, const void* data, size_t
         }
     }
     // lower level will catch other errors (range, permissions, etc.)
-    return write_raw_wrapper(start_row, data, count_of_bytes);
+    otp_rmw_lock();
+    bool result = write_raw_wrapper(start_row, data, count_of_bytes);
+    otp_rmw_unlock();
+    return result;
 }
 
                  
\ No newline at end of file
@@ -0,0 +1,8 @@
+#pragma once
+// Host stub: debug output is discarded
+#define PRINT_FATAL(...)   ((void)0)
+#define PRINT_ERROR(...)   ((void)0)
+#define PRINT_WARNING(...) ((void)0)
+#define PRINT_INFO(...)    ((void)0)
+#define PRINT_VERBOSE(...) ((void)0)
+#define PRINT_DEBUG(...)   ((void)0)
@@ -0,0 +1,14 @@
+#pragma once
+// Host stub: one core and no interrupts, so spin locks never contend
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef volatile uint32_t spin_lock_t;
+static inline spin_lock_t* spin_lock_instance(unsigned lock_num) { static spin_lock_t locks[32]; return &locks[lock_num]; }
+static inline int spin_lock_claim_unused(bool required) { static int next = 24; (void)required; return next++; }
+static inline uint32_t spin_lock_blocking(spin_lock_t* lock) { *lock = 1u; return 0u; }
+static inline void spin_unlock(spin_lock_t* lock, uint32_t saved_irq) { (void)saved_irq; *lock = 0u; }
+static inline uint32_t save_and_disable_interrupts(void) { return 0u; }
+static inline void restore_interrupts(uint32_t status) { (void)status; }
+static inline void tight_loop_contents(void) {}
+static inline unsigned get_core_num(void) { return 0u; }
@@ -0,0 +1,14 @@
+#pragma once
+// Host stub: microsecond clock from the host's monotonic clock
+#include <stdint.h>
+#include <time.h>
+
+static inline uint64_t time_us_64(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return ((uint64_t)t.tv_sec * 1000000u) + ((uint64_t)t.tv_nsec / 1000u);
+}
+static inline void busy_wait_us_32(uint32_t delay_us) {
+    uint64_t end = time_us_64() + delay_us;
+    while (time_us_64() < end) { }
+}
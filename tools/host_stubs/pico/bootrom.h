@@ -0,0 +1,18 @@
+#pragma once
+// Host stub: OTP geometry and rom_func_otp_access(), which each test defines
+#include <stdint.h>
+#include <stddef.h>
+
+#define NUM_OTP_ROWS       0x1000u
+#define NUM_OTP_PAGES      64u
+#define NUM_OTP_PAGE_ROWS  64u
+#define OTP_CMD_WRITE_BITS 0x00010000u
+#define OTP_CMD_ECC_BITS   0x00020000u
+#define OTP_CMD_ROW_BITS   0x0000ffffu
+
+#define BOOTROM_OK                   0
+#define BOOTROM_ERROR_NOT_PERMITTED  -4
+#define BOOTROM_ERROR_LOCK_REQUIRED  -19
+
+typedef struct { uint32_t flags; } otp_cmd_t;
+int rom_func_otp_access(uint8_t* buf, uint32_t buf_len, otp_cmd_t cmd);
@@ -0,0 +1,20 @@
+#pragma once
+// Host stub: one core.  Each translation unit has its own lock state, so a test that
+// includes a library .c file can check that the locks are released, or refuse them
+// (as if another user held them) with g_host_bootrom_lock_refuse.
+#include <stdbool.h>
+#include <stddef.h>
+#define BOOTROM_LOCK_OTP 2
+static bool g_host_bootrom_lock_held[8];
+static bool (*g_host_bootrom_lock_refuse)(unsigned lock_num) = NULL; // optional
+static inline bool bootrom_try_acquire_lock(unsigned lock_num) {
+    if (g_host_bootrom_lock_held[lock_num] ||
+        ((g_host_bootrom_lock_refuse != NULL) && g_host_bootrom_lock_refuse(lock_num))) {
+        return false;
+    }
+    g_host_bootrom_lock_held[lock_num] = true;
+    return true;
+}
+static inline void bootrom_release_lock(unsigned lock_num) {
+    g_host_bootrom_lock_held[lock_num] = false;
+}
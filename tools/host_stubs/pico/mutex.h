@@ -0,0 +1,14 @@
+#pragma once
+// Host stub: one core, so a recursive mutex only counts its depth
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef int8_t lock_owner_id_t;
+#define LOCK_INVALID_OWNER_ID ((lock_owner_id_t)-1)
+#define lock_get_caller_owner_id() ((lock_owner_id_t)0)
+
+typedef struct { uint32_t enter_count; } recursive_mutex_t;
+#define auto_init_recursive_mutex(name) static recursive_mutex_t name = { 0u }
+static inline void recursive_mutex_enter_blocking(recursive_mutex_t* m) { ++m->enter_count; }
+static inline bool recursive_mutex_try_enter(recursive_mutex_t* m, uint32_t* owner_out) { (void)owner_out; ++m->enter_count; return true; }
+static inline void recursive_mutex_exit(recursive_mutex_t* m) { --m->enter_count; }
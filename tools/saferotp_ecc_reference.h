@@ -0,0 +1,21 @@
+#pragma once
+
+#ifndef SAFEROTP_ECC_REFERENCE_H
+#define SAFEROTP_ECC_REFERENCE_H
+
+#include "saferotp_ecc.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// The original (loop-based) encoder and decoder, for host tools only.
+// See saferotp_ecc_reference.c.
+uint32_t ref_calculate_ecc(uint16_t x);
+uint32_t ref_decode_raw(uint32_t raw_data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SAFEROTP_ECC_REFERENCE_H
@@ -0,0 +1,351 @@
+// Exhaustive verifier and benchmark for the ECC decoder.
+//
+//     saferotp_ecc_verify [--threads N] [--bench]
+//
+// Verify (always): every one of the 2^24 raw row values is decoded by
+// saferotp_decode_raw(), saferotp_decode_raw_batch() (and each of its kernels that
+// this CPU supports, see saferotp_decode_raw_batch_kernel()), saferotp_decode_raw_page()
+// and the original decoder (saferotp_ecc_reference.c).  All must agree, and:
+//   * a successful result has only the low 16 bits set, and the raw value is
+//     at most one bit away from the normal or the BRBP-inverted encoding of it
+//     (the inverted encoding only if BRBP != 0b00, the normal only if BRBP != 0b11);
+//   * the error codes documented as "not returned" are never returned.
+// Each result is tallied by error code.  These tallies are the ones listed in
+// saferotp_ecc.h, and the run fails if they differ from that list.
+// Every one of the 2^16 values is also encoded by saferotp_calculate_ecc_page()
+// and saferotp_calculate_ecc_x32() (bit-sliced), saferotp_calculate_ecc_batch()
+// and each of its kernels, in runs of every length from 1 to 67 (so every kernel's
+// remainder handling is used), and compared against the original encoder.
+// The work is split across threads (default: one per CPU); the results do not
+// depend on the count of threads.
+//
+// Bench (--bench): single-threaded nanoseconds per row, for each decoder,
+// over all 2^24 raw values, and per encode, for saferotp_calculate_ecc() and
+// the original (LOOP) encoder, over all 2^16 values.  saferotp_ecc_verify is
+// built with the TABLE8 encoder, and saferotp_ecc_verify_loop with the LOOP
+// encoder (see SAFEROTP_ECC_ENCODER in saferotp_ecc.c).
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#include "saferotp_ecc.h"
+#include "saferotp_ecc_reference.h"
+
+#define xRAW_VALUE_COUNT  (1u << 24)
+#define xROWS_PER_BLOCK   64u // saferotp_decode_raw_page() decodes one page of rows
+#define xMAX_THREADS      256u
+#define xENCODE_REPEATS   200u
+#define xMAX_ENCODE_RUN   67u // longest run of values passed to one encode batch call
+#ifndef SAFEROTP_ECC_VERIFY_ENCODER_NAME
+    #define SAFEROTP_ECC_VERIFY_ENCODER_NAME "TABLE8"
+#endif
+
+typedef enum _X_TALLY {
+    X_TALLY_SUCCESS = 0,
+    X_TALLY_DETECTED_MULTI_BIT_ERROR,
+    X_TALLY_BRBP_NEITHER_DECODING_VALID,
+    X_TALLY_NOT_VALID_SINGLE_BIT_FLIP,
+    X_TALLY_INTERNAL_ERROR_BRBP_BIT,
+    X_TALLY_OTHER, // any other result is an error
+    X_TALLY_COUNT,
+} X_TALLY;
+static const char * const x_tally_names[X_TALLY_COUNT] = {
+    "decode successfully",
+    "DETECTED_MULTI_BIT_ERROR",
+    "BRBP_NEITHER_DECODING_VALID",
+    "NOT_VALID_SINGLE_BIT_FLIP",
+    "INTERNAL_ERROR_BRBP_BIT",
+    "any other result",
+};
+// Must match the list in saferotp_ecc.h
+static const uint32_t x_expected_tallies[X_TALLY_COUNT] = {
+    3276800u, // 65,536 values x 2 polarities x (1 + 24 single-bit flips)
+    3932160u,
+    8126464u,
+    1310720u,
+     131072u,
+          0u,
+};
+
+typedef struct _X_THREAD_WORK {
+    pthread_t thread;
+    uint32_t  first_raw;
+    uint32_t  end_raw;
+    uint32_t  tallies[X_TALLY_COUNT];
+    uint32_t  failures;
+    uint32_t  first_failure_raw;
+} X_THREAD_WORK;
+
+static X_TALLY x_tally_of(uint32_t result) {
+    switch (result) {
+        case SAFEROTP_ECC_ERROR_DETECTED_MULTI_BIT_ERROR:    return X_TALLY_DETECTED_MULTI_BIT_ERROR;
+        case SAFEROTP_ECC_ERROR_BRBP_NEITHER_DECODING_VALID: return X_TALLY_BRBP_NEITHER_DECODING_VALID;
+        case SAFEROTP_ECC_ERROR_NOT_VALID_SINGLE_BIT_FLIP:   return X_TALLY_NOT_VALID_SINGLE_BIT_FLIP;
+        case SAFEROTP_ECC_ERROR_INTERNAL_ERROR_BRBP_BIT:     return X_TALLY_INTERNAL_ERROR_BRBP_BIT;
+        default:
+            return ((result & 0xFF000000u) == 0u) ? X_TALLY_SUCCESS : X_TALLY_OTHER;
+    }
+}
+// true if a successful result is consistent with the raw value it was decoded from
+static bool x_success_is_valid(uint32_t raw, uint32_t result) {
+    if ((result & 0xFFFF0000u) != 0u) {
+        return false;
+    }
+    uint32_t brbp = (raw >> 22) & 0x3u;
+    uint32_t normal = saferotp_calculate_ecc((uint16_t)result);
+    uint32_t inverted = normal ^ 0x00FFFFFFu;
+    return ((brbp != 0x3u) && (__builtin_popcount(normal ^ raw) <= 1)) ||
+           ((brbp != 0x0u) && (__builtin_popcount(inverted ^ raw) <= 1));
+}
+static void* x_verify_range(void* context) {
+    X_THREAD_WORK * work = (X_THREAD_WORK*)context;
+    uint32_t raw[xROWS_PER_BLOCK];
+    uint32_t batch[xROWS_PER_BLOCK];
+    uint32_t page[xROWS_PER_BLOCK];
+    uint32_t kernel_out[SAFEROTP_ECC_BATCH_KERNEL_COUNT][xROWS_PER_BLOCK];
+    bool kernel_ran[SAFEROTP_ECC_BATCH_KERNEL_COUNT];
+    for (uint32_t block = work->first_raw; block < work->end_raw; block += xROWS_PER_BLOCK) {
+        for (uint32_t i = 0; i < xROWS_PER_BLOCK; ++i) {
+            raw[i] = block + i;
+        }
+        saferotp_decode_raw_batch(raw, batch, xROWS_PER_BLOCK);
+        saferotp_decode_raw_page(raw, page);
+        // Each kernel decodes the block in two calls, split at a point that varies by block,
+        // so every remainder length (and unaligned start) is used
+        uint32_t split = (block / xROWS_PER_BLOCK) % xROWS_PER_BLOCK;
+        for (uint8_t k = 0u; k < SAFEROTP_ECC_BATCH_KERNEL_COUNT; ++k) {
+            kernel_ran[k] = saferotp_decode_raw_batch_kernel(k, raw, kernel_out[k], split) &&
+                            saferotp_decode_raw_batch_kernel(k, raw + split, kernel_out[k] + split, xROWS_PER_BLOCK - split);
+        }
+        for (uint32_t i = 0; i < xROWS_PER_BLOCK; ++i) {
+            uint32_t result = saferotp_decode_raw(raw[i]);
+            X_TALLY tally = x_tally_of(result);
+            bool ok = (result == ref_decode_raw(raw[i])) &&
+                      (result == batch[i]) &&
+                      (result == page[i]) &&
+                      (tally != X_TALLY_OTHER) &&
+                      ((tally != X_TALLY_SUCCESS) || x_success_is_valid(raw[i], result));
+            for (uint8_t k = 0u; k < SAFEROTP_ECC_BATCH_KERNEL_COUNT; ++k) {
+                ok = ok && (!kernel_ran[k] || (result == kernel_out[k][i]));
+            }
+            if (!ok) {
+                if (work->failures == 0u) {
+                    work->first_failure_raw = raw[i];
+                }
+                ++work->failures;
+            }
+            ++work->tallies[tally];
+        }
+    }
+    return NULL;
+}
+static const char * const x_kernel_names[SAFEROTP_ECC_BATCH_KERNEL_COUNT] = {
+    "portable",
+    "SSE4.1",
+    "AVX2",
+};
+// Encodes all 2^16 values with `encode`, in runs of 1, 2, ... xMAX_ENCODE_RUN values
+// (then 1 again); returns the count of results that differ from `expected`.
+static uint32_t x_count_encode_mismatches(bool (*encode)(uint8_t, const uint16_t*, uint32_t*, size_t), uint8_t kernel, const uint16_t* values, const uint32_t* expected) {
+    static uint32_t out[1u << 16];
+    size_t run = 1u;
+    for (size_t first = 0u; first < (1u << 16); first += run, run = (run % xMAX_ENCODE_RUN) + 1u) {
+        if (run > (1u << 16) - first) {
+            run = (1u << 16) - first;
+        }
+        if (!encode(kernel, values + first, out + first, run)) {
+            return 0u; // kernel not supported on this CPU
+        }
+    }
+    uint32_t mismatches = 0u;
+    for (size_t i = 0u; i < (1u << 16); ++i) {
+        if (out[i] != expected[i]) {
+            if (mismatches == 0u) {
+                printf("first encode failure: value 0x%04" PRIx16 "\n", values[i]);
+            }
+            ++mismatches;
+        }
+    }
+    return mismatches;
+}
+static bool x_calculate_ecc_batch(uint8_t ignored, const uint16_t* values, uint32_t* out, size_t count) {
+    (void)ignored;
+    saferotp_calculate_ecc_batch(values, out, count);
+    return true;
+}
+// Every encoder against the original encoder, for all 2^16 values; returns the count of mismatches
+static uint32_t x_verify_encoders(void) {
+    static uint16_t values[1u << 16];
+    static uint32_t expected[1u << 16];
+    uint32_t failures = 0u;
+    for (uint32_t value = 0u; value < (1u << 16); ++value) {
+        values[value] = (uint16_t)value;
+        expected[value] = ref_calculate_ecc((uint16_t)value);
+        if (saferotp_calculate_ecc((uint16_t)value) != expected[value]) {
+            ++failures;
+        }
+    }
+    // Bit-sliced encoders, one page (or 32 values) at a time
+    static uint32_t page[1u << 16];
+    static uint32_t x32[1u << 16];
+    for (uint32_t first = 0u; first < (1u << 16); first += xROWS_PER_BLOCK) {
+        saferotp_calculate_ecc_page(&values[first], &page[first]);
+    }
+    for (uint32_t first = 0u; first < (1u << 16); first += 32u) {
+        saferotp_calculate_ecc_x32(&values[first], &x32[first]);
+    }
+    for (uint32_t value = 0u; value < (1u << 16); ++value) {
+        if ((page[value] != expected[value]) || (x32[value] != expected[value])) {
+            if (failures == 0u) {
+                printf("first bit-sliced encode failure: value 0x%04" PRIx32 "\n", value);
+            }
+            ++failures;
+        }
+    }
+    failures += x_count_encode_mismatches(x_calculate_ecc_batch, 0u, values, expected);
+    printf("All 2^16 values encoded, by saferotp_calculate_ecc(), saferotp_calculate_ecc_page(), saferotp_calculate_ecc_x32(), saferotp_calculate_ecc_batch(), and batch kernels:");
+    for (uint8_t k = 0u; k < SAFEROTP_ECC_BATCH_KERNEL_COUNT; ++k) {
+        uint32_t probe;
+        uint16_t zero = 0u;
+        if (saferotp_calculate_ecc_batch_kernel(k, &zero, &probe, 1u)) {
+            printf(" %s", x_kernel_names[k]);
+            failures += x_count_encode_mismatches(saferotp_calculate_ecc_batch_kernel, k, values, expected);
+        }
+    }
+    printf("\n");
+    return failures;
+}
+static bool x_verify(unsigned thread_count) {
+    static X_THREAD_WORK work[xMAX_THREADS];
+    uint32_t blocks = xRAW_VALUE_COUNT / xROWS_PER_BLOCK;
+    for (unsigned t = 0; t < thread_count; ++t) {
+        memset(&work[t], 0, sizeof(X_THREAD_WORK));
+        work[t].first_raw = (uint32_t)(((uint64_t)blocks * t / thread_count) * xROWS_PER_BLOCK);
+        work[t].end_raw   = (uint32_t)(((uint64_t)blocks * (t + 1u) / thread_count) * xROWS_PER_BLOCK);
+        if (pthread_create(&work[t].thread, NULL, x_verify_range, &work[t]) != 0) {
+            fprintf(stderr, "failed to start thread %u\n", t);
+            exit(2);
+        }
+    }
+    uint32_t tallies[X_TALLY_COUNT] = { 0 };
+    uint32_t failures = 0u;
+    for (unsigned t = 0; t < thread_count; ++t) {
+        pthread_join(work[t].thread, NULL);
+        for (unsigned k = 0; k < X_TALLY_COUNT; ++k) {
+            tallies[k] += work[t].tallies[k];
+        }
+        if (work[t].failures != 0u && failures == 0u) {
+            printf("first failure: raw 0x%06" PRIx32 "\n", work[t].first_failure_raw);
+        }
+        failures += work[t].failures;
+    }
+
+    bool tallies_match = true;
+    printf("All 2^24 raw values decoded, using %u thread(s), including batch kernels:", thread_count);
+    for (uint8_t k = 0u; k < SAFEROTP_ECC_BATCH_KERNEL_COUNT; ++k) {
+        uint32_t probe = 0u;
+        if (saferotp_decode_raw_batch_kernel(k, &probe, &probe, 1u)) {
+            printf(" %s", x_kernel_names[k]);
+        }
+    }
+    printf("\n");
+    for (unsigned k = 0; k < X_TALLY_COUNT; ++k) {
+        bool match = (tallies[k] == x_expected_tallies[k]);
+        tallies_match = tallies_match && match;
+        printf("    %10" PRIu32 "  %s%s\n", tallies[k], x_tally_names[k], match ? "" : "  ** differs from saferotp_ecc.h **");
+    }
+    failures += x_verify_encoders();
+    printf("%" PRIu32 " values failed verification\n", failures);
+    return (failures == 0u) && tallies_match;
+}
+
+static double x_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + ((double)ts.tv_nsec * 1e-9);
+}
+static volatile uint32_t x_sink;
+static void x_bench_decode(void) {
+    static uint32_t raw[xRAW_VALUE_COUNT];
+    static uint32_t out[xRAW_VALUE_COUNT];
+    for (uint32_t i = 0; i < xRAW_VALUE_COUNT; ++i) {
+        raw[i] = i;
+    }
+    uint32_t sum = 0u;
+    double t0 = x_now();
+    for (uint32_t i = 0; i < xRAW_VALUE_COUNT; ++i) {
+        sum += ref_decode_raw(raw[i]);
+    }
+    double t1 = x_now();
+    for (uint32_t i = 0; i < xRAW_VALUE_COUNT; ++i) {
+        sum += saferotp_decode_raw(raw[i]);
+    }
+    double t2 = x_now();
+    saferotp_decode_raw_batch(raw, out, xRAW_VALUE_COUNT);
+    double t3 = x_now();
+    for (uint32_t i = 0; i < xRAW_VALUE_COUNT; i += xROWS_PER_BLOCK) {
+        saferotp_decode_raw_page(&raw[i], &out[i]);
+    }
+    double t4 = x_now();
+    x_sink = sum + out[xRAW_VALUE_COUNT - 1u];
+    printf("Decode, ns per row (single thread, all 2^24 raw values):\n");
+    printf("    %7.2f  original decoder (saferotp_ecc_reference.c)\n", (t1 - t0) * 1e9 / xRAW_VALUE_COUNT);
+    printf("    %7.2f  saferotp_decode_raw()\n",                      (t2 - t1) * 1e9 / xRAW_VALUE_COUNT);
+    printf("    %7.2f  saferotp_decode_raw_batch()\n",                (t3 - t2) * 1e9 / xRAW_VALUE_COUNT);
+    printf("    %7.2f  saferotp_decode_raw_page() (bitslice)\n",      (t4 - t3) * 1e9 / xRAW_VALUE_COUNT);
+}
+
+static void x_bench_encode(void) {
+    uint32_t sum = 0u;
+    double t0 = x_now();
+    for (uint32_t r = 0u; r < xENCODE_REPEATS; ++r) {
+        for (uint32_t value = 0u; value < (1u << 16); ++value) {
+            sum += ref_calculate_ecc((uint16_t)(value ^ r));
+        }
+    }
+    double t1 = x_now();
+    for (uint32_t r = 0u; r < xENCODE_REPEATS; ++r) {
+        for (uint32_t value = 0u; value < (1u << 16); ++value) {
+            sum += saferotp_calculate_ecc((uint16_t)(value ^ r));
+        }
+    }
+    double t2 = x_now();
+    x_sink = sum;
+    double encodes = (double)xENCODE_REPEATS * (double)(1u << 16);
+    printf("Encode, ns per value (single thread, all 2^16 values):\n");
+    printf("    %7.2f  original LOOP encoder (saferotp_ecc_reference.c)\n", (t1 - t0) * 1e9 / encodes);
+    printf("    %7.2f  saferotp_calculate_ecc() (%s)\n", (t2 - t1) * 1e9 / encodes, SAFEROTP_ECC_VERIFY_ENCODER_NAME);
+}
+
+int main(int argc, char** argv) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    unsigned thread_count = (cpus > 0) ? (unsigned)cpus : 1u;
+    bool bench = false;
+    for (int i = 1; i < argc; ++i) {
+        if ((strcmp(argv[i], "--threads") == 0) && (i + 1 < argc)) {
+            thread_count = (unsigned)strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--bench") == 0) {
+            bench = true;
+        } else {
+            fprintf(stderr, "usage: %s [--threads N] [--bench]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (thread_count == 0u) {
+        thread_count = 1u;
+    } else if (thread_count > xMAX_THREADS) {
+        thread_count = xMAX_THREADS;
+    }
+    bool ok = x_verify(thread_count);
+    if (bench) {
+        x_bench_decode();
+        x_bench_encode();
+    }
+    return ok ? 0 : 1;
+}
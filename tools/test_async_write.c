@@ -0,0 +1,296 @@
+// Checks saferotp_async_write() / saferotp_poll() against the virtual OTP backend.
+// Each round starts from a random OTP image, then submits random requests (every
+// encoding, overlapping ranges, stray and unreadable rows) interleaved with polls,
+// including submits to a full queue and completion callbacks that queue the next
+// request.  The same requests are then written in completion order with sequential
+// saferotp_writev() calls from the same image.  The per-request statuses and the
+// final OTP images must match.  Returns non-zero on any mismatch.
+//
+// Before virtualizing, a short bootrom-backed round also polls from inside a bootrom
+// call (as a second task on the same core would), which must not step the request.
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <inttypes.h>
+#include "pico/bootrom.h"
+#include "saferotp.h"
+
+#define xROUNDS                   1000u
+#define xMAX_REQUESTS             24u
+#define xMAX_REQUEST_BYTES        96u
+#define xMAX_REPORTED_MISMATCHES  8u
+#define xIMAGE_BASE_ROW           0x100u
+#define xIMAGE_ROWS               0x200u
+
+#pragma region    // Fake bootrom (only used before virtualization)
+static uint32_t g_rom_otp[NUM_OTP_ROWS];
+static bool g_rom_poll_during_writes = false;
+static uint32_t g_rom_nested_polls = 0u;
+static uint32_t g_rom_nested_polls_without_work = 0u;
+
+// Reads fail if any row is unreadable (top byte set); writes OR bits, as the fuses would.
+// Optionally, each write polls the queue, as another task preempting this one would.
+int rom_func_otp_access(uint8_t* buf, uint32_t buf_len, otp_cmd_t cmd) {
+    uint32_t row = cmd.flags & OTP_CMD_ROW_BITS;
+    uint32_t row_count = buf_len / sizeof(uint32_t);
+    if ((row + row_count) > NUM_OTP_ROWS) {
+        return BOOTROM_ERROR_NOT_PERMITTED;
+    }
+    for (uint32_t i = 0u; i < row_count; ++i) {
+        if ((g_rom_otp[row + i] & 0xFF000000u) != 0u) {
+            return BOOTROM_ERROR_NOT_PERMITTED;
+        }
+    }
+    if ((cmd.flags & OTP_CMD_WRITE_BITS) == 0u) {
+        memcpy(buf, &g_rom_otp[row], buf_len);
+        return BOOTROM_OK;
+    }
+    for (uint32_t i = 0u; i < row_count; ++i) {
+        uint32_t value;
+        memcpy(&value, &buf[i * sizeof(uint32_t)], sizeof(uint32_t));
+        g_rom_otp[row + i] |= value;
+    }
+    if (g_rom_poll_during_writes) {
+        g_rom_poll_during_writes = false; // no deeper nesting
+        if (!saferotp_poll()) {
+            ++g_rom_nested_polls_without_work; // the request being written is still queued
+        }
+        ++g_rom_nested_polls;
+        g_rom_poll_during_writes = true;
+    }
+    return BOOTROM_OK;
+}
+void SaferOtp_WaitForKey_impl(void) {
+}
+#pragma endregion // Fake bootrom
+
+#pragma region    // Random requests
+static uint32_t g_rng = 0x12345678u;
+static uint32_t next_random(void) {
+    // xorshift32
+    g_rng ^= g_rng << 13;
+    g_rng ^= g_rng >> 17;
+    g_rng ^= g_rng << 5;
+    return g_rng;
+}
+
+typedef struct _TEST_REQUEST {
+    uint8_t  data[xMAX_REQUEST_BYTES];
+    SAFEROTP_IOV iov;
+    SAFEROTP_ASYNC_HANDLE handle;
+    uint8_t  async_status;
+    uint32_t completions;
+    bool     requeue_next; // its callback submits the next request
+} TEST_REQUEST;
+
+static void random_image(uint32_t image[NUM_OTP_ROWS]) {
+    memset(image, 0, NUM_OTP_ROWS * sizeof(uint32_t));
+    for (uint32_t row = xIMAGE_BASE_ROW; row < (xIMAGE_BASE_ROW + xIMAGE_ROWS); ++row) {
+        switch (next_random() % 10u) {
+            case 1:  image[row] = saferotp_calculate_ecc((uint16_t)next_random());               break;
+            case 2:  image[row] = 1u << (next_random() % 24u);                                   break;
+            case 3:  image[row] = next_random() & next_random() & next_random() & 0x00FFFFFFu;   break;
+            case 4:  image[row] = 0xFFFFFFFFu; /* unreadable */                                  break;
+            default: image[row] = 0u;                                                            break;
+        }
+    }
+}
+static void random_request(TEST_REQUEST* r) {
+    memset(r, 0, sizeof(TEST_REQUEST));
+    uint8_t encoding = (uint8_t)(next_random() % 5u);
+    size_t units = 1u + (next_random() % (((next_random() % 3u) != 0u) ? 4u : 24u));
+    size_t bytes;
+    if (encoding == SAFEROTP_IOV_ENCODING_ECC) {
+        bytes = (units * 2u) - (next_random() & 1u); // odd byte counts are allowed
+    } else if (encoding == SAFEROTP_IOV_ENCODING_BYTE3X) {
+        bytes = units;
+    } else {
+        if ((encoding == SAFEROTP_IOV_ENCODING_RBIT8) && (units > 12u)) {
+            units = 12u;
+        }
+        bytes = units * sizeof(uint32_t);
+    }
+    for (size_t i = 0; i < bytes; ++i) {
+        r->data[i] = (uint8_t)(next_random() & next_random());
+    }
+    if (encoding != SAFEROTP_IOV_ENCODING_ECC && encoding != SAFEROTP_IOV_ENCODING_BYTE3X) {
+        for (size_t i = 3u; i < bytes; i += 4u) {
+            r->data[i] = 0u; // 24-bit values
+        }
+    }
+    r->iov.buffer = r->data;
+    r->iov.count_of_bytes = bytes;
+    r->iov.start_row = (uint16_t)(xIMAGE_BASE_ROW + (next_random() % (xIMAGE_ROWS - 0x60u)));
+    r->iov.encoding = encoding;
+    r->requeue_next = (next_random() % 4u) == 0u;
+}
+#pragma endregion // Random requests
+
+#pragma region    // Submitting and polling
+static TEST_REQUEST g_requests[xMAX_REQUESTS];
+static size_t g_request_count = 0u;
+static size_t g_next_submit = 0u;       // next request to submit
+static size_t g_completion_order[xMAX_REQUESTS];
+static size_t g_completed = 0u;
+static uint32_t g_mismatches = 0u;
+static uint32_t g_written = 0u;      // requests that completed with SAFEROTP_IOV_STATUS_OK
+static uint32_t g_not_written = 0u;  // requests that completed with any other status
+static uint32_t g_queue_full = 0u;   // submits rejected because the queue was full
+static uint32_t g_requeued = 0u;     // requests submitted from a callback
+
+static void report(const char* what, uint32_t round, size_t index) {
+    if (g_mismatches < xMAX_REPORTED_MISMATCHES) {
+        printf("round %" PRIu32 " request %zu: %s\n", round, index, what);
+    }
+    ++g_mismatches;
+}
+static void on_complete(SAFEROTP_ASYNC_HANDLE handle, uint8_t status, void* context);
+// Returns false (without submitting) if the queue is full
+static bool submit_next_with_callback(void) {
+    TEST_REQUEST* r = &g_requests[g_next_submit];
+    r->handle = saferotp_async_write(r->iov.encoding, r->iov.start_row, r->iov.buffer, r->iov.count_of_bytes, on_complete, r);
+    if (r->handle == SAFEROTP_ASYNC_INVALID_HANDLE) {
+        return false;
+    }
+    ++g_next_submit;
+    return true;
+}
+static void on_complete(SAFEROTP_ASYNC_HANDLE handle, uint8_t status, void* context) {
+    TEST_REQUEST* r = (TEST_REQUEST*)context;
+    size_t index = (size_t)(r - g_requests);
+    if (handle != r->handle) {
+        report("callback handle differs", 0u, index);
+    }
+    r->async_status = status;
+    ++r->completions;
+    g_completion_order[g_completed++] = index;
+    // the slot is already released, so a re-queue from the callback must succeed
+    if (r->requeue_next && (g_next_submit < g_request_count)) {
+        if (!submit_next_with_callback()) {
+            report("re-queue from the callback failed", 0u, index);
+        }
+        ++g_requeued;
+    }
+}
+static size_t outstanding(void) {
+    return g_next_submit - g_completed;
+}
+#pragma endregion // Submitting and polling
+
+static void run_round(uint32_t round, bool virtualized) {
+    static uint32_t image[NUM_OTP_ROWS];
+    static uint32_t async_result[NUM_OTP_ROWS];
+    static uint32_t sync_result[NUM_OTP_ROWS];
+    random_image(image);
+    g_request_count = 1u + (next_random() % xMAX_REQUESTS);
+    for (size_t i = 0; i < g_request_count; ++i) {
+        random_request(&g_requests[i]);
+    }
+    g_next_submit = 0u;
+    g_completed = 0u;
+
+    // 1. Asynchronous writes
+    if (virtualized) {
+        (void)saferotp_virtualization_restore(0u, image, sizeof(image));
+    } else {
+        memcpy(g_rom_otp, image, sizeof(image));
+    }
+    bool fill_queue = (next_random() % 4u) == 0u;
+    g_rom_poll_during_writes = !virtualized;
+    while ((g_next_submit < g_request_count) || (g_completed < g_request_count)) {
+        while ((g_next_submit < g_request_count) && (fill_queue || ((next_random() % 3u) != 0u))) {
+            size_t was_outstanding = outstanding();
+            if (!submit_next_with_callback()) {
+                if (was_outstanding != SAFEROTP_ASYNC_QUEUE_DEPTH) {
+                    report("submit failed with the queue not full", round, g_next_submit);
+                }
+                ++g_queue_full;
+                break;
+            }
+        }
+        (void)saferotp_poll();
+    }
+    g_rom_poll_during_writes = false;
+    if (saferotp_poll()) {
+        report("poll reports work after every request completed", round, 0u);
+    }
+    if (virtualized) {
+        (void)saferotp_virtualization_save(0u, async_result, sizeof(async_result));
+    } else {
+        memcpy(async_result, g_rom_otp, sizeof(async_result));
+    }
+
+    // 2. The same requests, in completion order, with sequential saferotp_writev()
+    if (virtualized) {
+        (void)saferotp_virtualization_restore(0u, image, sizeof(image));
+    } else {
+        memcpy(g_rom_otp, image, sizeof(image));
+    }
+    for (size_t i = 0; i < g_completed; ++i) {
+        if ((i > 0u) && (g_completion_order[i] <= g_completion_order[i - 1u])) {
+            report("requests completed out of submission order", round, g_completion_order[i]);
+        }
+        TEST_REQUEST* r = &g_requests[g_completion_order[i]];
+        SAFEROTP_IOV v = r->iov;
+        (void)saferotp_writev(&v, 1u);
+        if (v.status != r->async_status) {
+            report("status differs from saferotp_writev()", round, g_completion_order[i]);
+        }
+        if (r->async_status == SAFEROTP_IOV_STATUS_OK) {
+            ++g_written;
+        } else {
+            ++g_not_written;
+        }
+    }
+    for (size_t i = 0; i < g_request_count; ++i) {
+        if (g_requests[i].completions != 1u) {
+            report("callback not called exactly once", round, i);
+        }
+    }
+    if (virtualized) {
+        (void)saferotp_virtualization_save(0u, sync_result, sizeof(sync_result));
+    } else {
+        memcpy(sync_result, g_rom_otp, sizeof(sync_result));
+    }
+    if (memcmp(async_result, sync_result, sizeof(async_result)) != 0) {
+        report("final OTP image differs from saferotp_writev()", round, 0u);
+    }
+}
+
+int main(void) {
+    // A request submitted without a callback still completes, and the queue drains
+    uint32_t value = 0x00123456u;
+    if (saferotp_async_write(SAFEROTP_IOV_ENCODING_RAW, xIMAGE_BASE_ROW, &value, sizeof(value), NULL, NULL) == SAFEROTP_ASYNC_INVALID_HANDLE) {
+        report("submit without a callback failed", 0u, 0u);
+    }
+    while (saferotp_poll()) {
+    }
+    if (g_rom_otp[xIMAGE_BASE_ROW] != value) {
+        report("request without a callback was not written", 0u, 0u);
+    }
+    if (saferotp_async_write(0xFFu, xIMAGE_BASE_ROW, &value, sizeof(value), NULL, NULL) != SAFEROTP_ASYNC_INVALID_HANDLE) {
+        report("invalid encoding was queued", 0u, 0u);
+    }
+
+    // Bootrom-backed rounds, polling again from inside each bootrom write
+    for (uint32_t round = 0u; round < 50u; ++round) {
+        run_round(round, false);
+    }
+    if ((g_rom_nested_polls == 0u) || (g_rom_nested_polls_without_work != 0u)) {
+        report("nested polls were not made, or did not see the queued request", 0u, 0u);
+    }
+
+    // Virtual OTP rounds (every page ignored: the image is restored each round)
+    if (!saferotp_virtualization_init_pages(UINT64_MAX)) {
+        printf("virtualization failed to initialize\n");
+        return 1;
+    }
+    for (uint32_t round = 0u; round < xROUNDS; ++round) {
+        run_round(round, true);
+    }
+    printf("%" PRIu32 " written, %" PRIu32 " not written, %" PRIu32 " queue full, %" PRIu32 " re-queued, %" PRIu32 " nested polls\n",
+        g_written, g_not_written, g_queue_full, g_requeued, g_rom_nested_polls);
+    printf("%" PRIu32 " mismatches\n", g_mismatches);
+    return (g_mismatches == 0u) ? 0 : 1;
+}
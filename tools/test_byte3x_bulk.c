@@ -0,0 +1,186 @@
+// Checks the bulk BYTE3X functions (saferotp_read_data_byte3x() /
+// saferotp_write_data_byte3x()) against loops of saferotp_read_single_value_byte3x() /
+// saferotp_write_single_value_byte3x(), using a fake bootrom.  Each operation starts from
+// a random OTP image (blank rows, BYTE3X rows, rows with one differing copy, stray bits,
+// and unreadable rows), and reads or writes a random range of up to three pages of rows.
+//   * Reads: the return values must match, and so must the data when successful.
+//   * Writes: the return values must match; a rejected bulk write must leave the image
+//     unchanged, and a successful one must give the same image as the row-at-a-time writes.
+// Also checks a range with one incompatible row in the middle: the whole range is
+// rejected, and nothing is burned.  Returns non-zero on any mismatch.
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <inttypes.h>
+#include "pico/bootrom.h"
+#include "saferotp.h"
+
+#define xOPERATIONS               50000u
+#define xMAX_ROWS                 150u // spans up to three pages
+#define xMAX_REPORTED_MISMATCHES  8u
+#define xIMAGE_BASE_ROW           0x100u
+#define xIMAGE_ROWS               0x200u
+
+#pragma region    // Fake bootrom
+static uint32_t g_rom_otp[NUM_OTP_ROWS];
+
+// Reads fail if any row is unreadable (top byte set); writes OR bits, as the fuses would.
+int rom_func_otp_access(uint8_t* buf, uint32_t buf_len, otp_cmd_t cmd) {
+    uint32_t row = cmd.flags & OTP_CMD_ROW_BITS;
+    uint32_t row_count = buf_len / sizeof(uint32_t);
+    if ((row + row_count) > NUM_OTP_ROWS) {
+        return BOOTROM_ERROR_NOT_PERMITTED;
+    }
+    for (uint32_t i = 0u; i < row_count; ++i) {
+        if ((g_rom_otp[row + i] & 0xFF000000u) != 0u) {
+            return BOOTROM_ERROR_NOT_PERMITTED;
+        }
+    }
+    if ((cmd.flags & OTP_CMD_WRITE_BITS) == 0u) {
+        memcpy(buf, &g_rom_otp[row], buf_len);
+        return BOOTROM_OK;
+    }
+    for (uint32_t i = 0u; i < row_count; ++i) {
+        uint32_t value;
+        memcpy(&value, &buf[i * sizeof(uint32_t)], sizeof(uint32_t));
+        g_rom_otp[row + i] |= value;
+    }
+    return BOOTROM_OK;
+}
+void SaferOtp_WaitForKey_impl(void) {
+}
+#pragma endregion // Fake bootrom
+
+#pragma region    // Random images and values
+static uint32_t g_rng = 0xC0FFEE11u;
+static uint32_t next_random(void) {
+    // xorshift32
+    g_rng ^= g_rng << 13;
+    g_rng ^= g_rng >> 17;
+    g_rng ^= g_rng << 5;
+    return g_rng;
+}
+static uint32_t all_copies(uint8_t x) {
+    return (uint32_t)x * 0x010101u;
+}
+// Mostly blank rows, so that a fair share of the writes can succeed
+static void random_image(uint32_t image[NUM_OTP_ROWS], uint8_t values[NUM_OTP_ROWS]) {
+    memset(image, 0, NUM_OTP_ROWS * sizeof(uint32_t));
+    for (uint32_t row = xIMAGE_BASE_ROW; row < (xIMAGE_BASE_ROW + xIMAGE_ROWS); ++row) {
+        values[row] = (uint8_t)(next_random() & next_random());
+        switch (next_random() % 30u) {
+            case 0: case 1: case 2: case 3:
+                image[row] = all_copies(values[row]);                                              break;
+            case 4: case 5:
+                image[row] = all_copies(values[row]) ^ ((next_random() & 0xFFu) << (8u * (next_random() % 3u))); break;
+            case 6:
+                image[row] = 1u << (next_random() % 24u); /* stray bit */                          break;
+            case 7:
+                image[row] = 0xFFFFFFFFu; /* unreadable */                                         break;
+            default:
+                image[row] = 0u;                                                                   break;
+        }
+    }
+}
+#pragma endregion // Random images and values
+
+static uint32_t g_mismatches = 0u;
+static void report(const char* what, uint32_t op) {
+    if (g_mismatches < xMAX_REPORTED_MISMATCHES) {
+        printf("operation %" PRIu32 ": %s\n", op, what);
+    }
+    ++g_mismatches;
+}
+
+static void check_read(const uint32_t image[NUM_OTP_ROWS], uint16_t start_row, size_t count, uint32_t op) {
+    uint8_t expected[xMAX_ROWS];
+    uint8_t data[xMAX_ROWS];
+    memcpy(g_rom_otp, image, NUM_OTP_ROWS * sizeof(uint32_t));
+    bool expected_ok = true;
+    for (size_t i = 0; expected_ok && (i < count); ++i) {
+        expected_ok = saferotp_read_single_value_byte3x(start_row + i, &expected[i]);
+    }
+    bool result = saferotp_read_data_byte3x(start_row, data, count);
+    if (result != expected_ok) {
+        report("bulk read result differs from row-at-a-time reads", op);
+    } else if (result && (memcmp(data, expected, count) != 0)) {
+        report("bulk read data differs from row-at-a-time reads", op);
+    }
+}
+static void check_write(const uint32_t image[NUM_OTP_ROWS], const uint8_t values[NUM_OTP_ROWS], uint16_t start_row, size_t count, uint32_t op, uint32_t* written, uint32_t* rejected) {
+    static uint32_t expected_image[NUM_OTP_ROWS];
+    uint8_t data[xMAX_ROWS];
+    for (size_t i = 0; i < count; ++i) {
+        // usually compatible with the existing row: its voted value, plus some new bits
+        data[i] = (uint8_t)next_random();
+        if ((next_random() % 16u) != 0u) {
+            data[i] = values[start_row + i] | (uint8_t)(next_random() & next_random() & next_random());
+        }
+    }
+
+    // 1. One row at a time, stopping at the first failure
+    memcpy(g_rom_otp, image, NUM_OTP_ROWS * sizeof(uint32_t));
+    bool expected_ok = true;
+    for (size_t i = 0; expected_ok && (i < count); ++i) {
+        expected_ok = saferotp_write_single_value_byte3x(start_row + i, data[i]);
+    }
+    memcpy(expected_image, g_rom_otp, sizeof(expected_image));
+
+    // 2. Bulk write
+    memcpy(g_rom_otp, image, NUM_OTP_ROWS * sizeof(uint32_t));
+    bool result = saferotp_write_data_byte3x(start_row, data, count);
+    if (result != expected_ok) {
+        report(result ? "bulk write succeeded, but a row-at-a-time write failed" : "bulk write failed, but row-at-a-time writes succeeded", op);
+    }
+    if (!result) {
+        ++(*rejected);
+        if (memcmp(g_rom_otp, image, NUM_OTP_ROWS * sizeof(uint32_t)) != 0) {
+            report("bulk write was rejected, but changed the OTP image", op);
+        }
+        return;
+    }
+    ++(*written);
+    if (memcmp(g_rom_otp, expected_image, sizeof(expected_image)) != 0) {
+        report("bulk write image differs from row-at-a-time writes", op);
+    }
+}
+// A blank range with one incompatible row in the middle is rejected, without burning anything
+static void check_incompatible_row(void) {
+    uint8_t data[xMAX_ROWS];
+    for (size_t i = 0; i < xMAX_ROWS; ++i) {
+        data[i] = (uint8_t)(0x5Au ^ i);
+    }
+    memset(g_rom_otp, 0, sizeof(g_rom_otp));
+    uint16_t bad_row = xIMAGE_BASE_ROW + (xMAX_ROWS / 2u);
+    g_rom_otp[bad_row] = all_copies((uint8_t)~data[xMAX_ROWS / 2u]); // votes bits not in the new value
+    uint32_t bad_raw = g_rom_otp[bad_row];
+    if (saferotp_write_data_byte3x(xIMAGE_BASE_ROW, data, xMAX_ROWS)) {
+        report("range with an incompatible row was written", 0u);
+    }
+    for (uint32_t row = 0u; row < NUM_OTP_ROWS; ++row) {
+        if (g_rom_otp[row] != ((row == bad_row) ? bad_raw : 0u)) {
+            report("range with an incompatible row burned fuses", 0u);
+            break;
+        }
+    }
+}
+
+int main(void) {
+    static uint32_t image[NUM_OTP_ROWS];
+    static uint8_t values[NUM_OTP_ROWS];
+    uint32_t written = 0u;
+    uint32_t rejected = 0u;
+
+    check_incompatible_row();
+    for (uint32_t op = 0u; op < xOPERATIONS; ++op) {
+        random_image(image, values);
+        size_t count = 1u + (next_random() % (((next_random() % 4u) != 0u) ? 8u : xMAX_ROWS));
+        uint16_t start_row = (uint16_t)(xIMAGE_BASE_ROW + (next_random() % (xIMAGE_ROWS - xMAX_ROWS)));
+        check_read(image, start_row, count, op);
+        check_write(image, values, start_row, count, op, &written, &rejected);
+    }
+    printf("%" PRIu32 " written, %" PRIu32 " rejected\n", written, rejected);
+    printf("%" PRIu32 " mismatches\n", g_mismatches);
+    return (g_mismatches == 0u) ? 0 : 1;
+}
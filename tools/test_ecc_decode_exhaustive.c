@@ -0,0 +1,42 @@
+// Compares saferotp_decode_raw() against the original decoder (saferotp_ecc_reference.c)
+// for every one of the 2^24 possible raw row values, plus values with any of the top
+// 8 bits set (as returned for unreadable rows).  Also compares saferotp_calculate_ecc()
+// against the original encoder for all 2^16 values.  Returns non-zero on any mismatch.
+#include <stdio.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include "saferotp_ecc.h"
+#include "saferotp_ecc_reference.h"
+
+#define xMAX_REPORTED_MISMATCHES 8u
+
+int main(void) {
+    uint32_t mismatches = 0u;
+    for (uint32_t raw = 0u; raw < (1u << 24); ++raw) {
+        uint32_t expected = ref_decode_raw(raw);
+        uint32_t actual   = saferotp_decode_raw(raw);
+        if (expected != actual) {
+            if (mismatches < xMAX_REPORTED_MISMATCHES) {
+                printf("decode 0x%06" PRIx32 ": expected 0x%08" PRIx32 ", got 0x%08" PRIx32 "\n", raw, expected, actual);
+            }
+            ++mismatches;
+        }
+    }
+    static const uint32_t invalid_inputs[] = { 0x01000000u, 0x80000000u, 0x7F123456u, 0xFFFFFFFFu };
+    for (size_t i = 0; i < sizeof(invalid_inputs) / sizeof(invalid_inputs[0]); ++i) {
+        if (ref_decode_raw(invalid_inputs[i]) != saferotp_decode_raw(invalid_inputs[i])) {
+            printf("decode 0x%08" PRIx32 ": mismatch\n", invalid_inputs[i]);
+            ++mismatches;
+        }
+    }
+    for (uint32_t value = 0u; value < (1u << 16); ++value) {
+        if (ref_calculate_ecc((uint16_t)value) != saferotp_calculate_ecc((uint16_t)value)) {
+            if (mismatches < xMAX_REPORTED_MISMATCHES) {
+                printf("encode 0x%04" PRIx32 ": mismatch\n", value);
+            }
+            ++mismatches;
+        }
+    }
+    printf("%" PRIu32 " mismatches\n", mismatches);
+    return (mismatches == 0u) ? 0 : 1;
+}
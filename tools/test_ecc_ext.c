@@ -0,0 +1,272 @@
+// Checks the per-row status contract of saferotp_write_data_ecc_ext(), using a fake
+// bootrom.  Each operation starts from a random OTP image (blank rows, ECC rows, ECC
+// rows with a corrected bit flip, stray bits, and unreadable rows), and writes a random
+// range of up to three pages of rows (including odd byte counts), so that incompatible
+// and unreadable rows are mixed with writable ones.  Occasionally, the fake bootrom
+// silently drops the writes to one row of the range.  Each row is compared with
+// saferotp_write_single_value_ecc() of the same row, on the same image:
+//   * every row that can be written is written, and reads back as the requested value,
+//     and its status is the one saferotp_read_data_ecc_ext() reports (OK or CORRECTED);
+//   * every other row is unchanged, and its status is IO_ERROR if it is unreadable (or
+//     its write was dropped), and otherwise WRITE_INCOMPATIBLE;
+//   * the return value is true only if every row is OK or CORRECTED.
+// Also checks a fixed range with one incompatible and one unreadable row, and that a
+// write of zero bytes succeeds without touching the OTP or the status buffer.
+// Returns non-zero on any mismatch.
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <inttypes.h>
+#include "pico/bootrom.h"
+#include "saferotp.h"
+
+#define xOPERATIONS               40000u
+#define xMAX_WRITE_ROWS           150u // spans up to three pages
+#define xMAX_REPORTED_MISMATCHES  8u
+#define xIMAGE_BASE_ROW           0x100u
+#define xIMAGE_ROWS               0x200u
+#define xNO_DROPPED_ROW           0xFFFFFFFFu
+
+#pragma region    // Fake bootrom
+static uint32_t g_rom_otp[NUM_OTP_ROWS];
+static uint32_t g_dropped_row = xNO_DROPPED_ROW; // writes to this row report success, but burn nothing
+
+// Reads fail if any row is unreadable (top byte set); writes OR bits, as the fuses would.
+int rom_func_otp_access(uint8_t* buf, uint32_t buf_len, otp_cmd_t cmd) {
+    uint32_t row = cmd.flags & OTP_CMD_ROW_BITS;
+    uint32_t row_count = buf_len / sizeof(uint32_t);
+    if ((row + row_count) > NUM_OTP_ROWS) {
+        return BOOTROM_ERROR_NOT_PERMITTED;
+    }
+    for (uint32_t i = 0u; i < row_count; ++i) {
+        if ((g_rom_otp[row + i] & 0xFF000000u) != 0u) {
+            return BOOTROM_ERROR_NOT_PERMITTED;
+        }
+    }
+    if ((cmd.flags & OTP_CMD_WRITE_BITS) == 0u) {
+        memcpy(buf, &g_rom_otp[row], buf_len);
+        return BOOTROM_OK;
+    }
+    for (uint32_t i = 0u; i < row_count; ++i) {
+        uint32_t value;
+        memcpy(&value, &buf[i * sizeof(uint32_t)], sizeof(uint32_t));
+        if ((row + i) != g_dropped_row) {
+            g_rom_otp[row + i] |= value;
+        }
+    }
+    return BOOTROM_OK;
+}
+void SaferOtp_WaitForKey_impl(void) {
+}
+#pragma endregion // Fake bootrom
+
+#pragma region    // Random images and writes
+static uint32_t g_rng = 0x2545F491u;
+static uint32_t next_random(void) {
+    // xorshift32
+    g_rng ^= g_rng << 13;
+    g_rng ^= g_rng >> 17;
+    g_rng ^= g_rng << 5;
+    return g_rng;
+}
+// Enough blank rows that most ranges mix writable rows with rows that cannot be written
+static void random_image(uint32_t image[NUM_OTP_ROWS], uint16_t values[NUM_OTP_ROWS]) {
+    memset(image, 0, NUM_OTP_ROWS * sizeof(uint32_t));
+    for (uint32_t row = xIMAGE_BASE_ROW; row < (xIMAGE_BASE_ROW + xIMAGE_ROWS); ++row) {
+        values[row] = (uint16_t)next_random();
+        switch (next_random() % 20u) {
+            case 0: case 1: case 2: case 3:
+                image[row] = saferotp_calculate_ecc(values[row]);                                    break;
+            case 4: case 5:
+                image[row] = saferotp_calculate_ecc(values[row]) ^ (1u << (next_random() % 22u));    break;
+            case 6:
+                image[row] = 1u << (next_random() % 24u); /* stray bit */                            break;
+            case 7:
+                image[row] = 0xFFFFFFFFu; /* unreadable */                                           break;
+            default:
+                image[row] = 0u;                                                                     break;
+        }
+    }
+}
+// Values for the rows of the write: usually the value already stored (or a random
+// value for a blank row), sometimes a random value, which may not be writable.
+static size_t random_write(const uint32_t image[NUM_OTP_ROWS], const uint16_t values[NUM_OTP_ROWS], uint16_t* out_start_row, uint8_t* out_data) {
+    size_t row_count = 1u + (next_random() % (((next_random() % 4u) != 0u) ? 8u : xMAX_WRITE_ROWS));
+    uint16_t start_row = (uint16_t)(xIMAGE_BASE_ROW + (next_random() % (xIMAGE_ROWS - xMAX_WRITE_ROWS)));
+    for (size_t i = 0; i < row_count; ++i) {
+        uint16_t value = (uint16_t)next_random();
+        if ((image[start_row + i] != 0u) && ((next_random() % 4u) != 0u)) {
+            value = values[start_row + i];
+        }
+        out_data[(2u * i) + 0u] = (uint8_t)value;
+        out_data[(2u * i) + 1u] = (uint8_t)(value >> 8);
+    }
+    size_t count_of_bytes = 2u * row_count;
+    if ((next_random() & 1u) != 0u) {
+        // odd byte count: the final row is written with a zero high byte
+        --count_of_bytes;
+        out_data[count_of_bytes] = 0u;
+    }
+    *out_start_row = start_row;
+    return count_of_bytes;
+}
+#pragma endregion // Random images and writes
+
+static uint32_t g_mismatches = 0u;
+static void report(const char* what, uint32_t op, size_t index) {
+    if (g_mismatches < xMAX_REPORTED_MISMATCHES) {
+        printf("operation %" PRIu32 " row index %zu: %s\n", op, index, what);
+    }
+    ++g_mismatches;
+}
+static bool is_ok_status(uint8_t status) {
+    return (status == SAFEROTP_ROW_STATUS_OK) || (status == SAFEROTP_ROW_STATUS_CORRECTED);
+}
+
+static uint32_t g_rows_written = 0u;
+static uint32_t g_rows_incompatible = 0u;
+static uint32_t g_rows_io_error = 0u;
+
+// Checks one write of the range, against row-at-a-time writes of the same image
+static void check_write(const uint32_t image[NUM_OTP_ROWS], uint16_t start_row, const uint8_t* data, size_t count_of_bytes, uint32_t op) {
+    static uint32_t after[NUM_OTP_ROWS];
+    uint8_t status[xMAX_WRITE_ROWS];
+    size_t row_count = (count_of_bytes + 1u) / 2u;
+
+    memcpy(g_rom_otp, image, NUM_OTP_ROWS * sizeof(uint32_t));
+    memset(status, 0xFF, sizeof(status));
+    bool result = saferotp_write_data_ecc_ext(start_row, data, count_of_bytes, status);
+    memcpy(after, g_rom_otp, sizeof(after));
+
+    bool all_ok = true;
+    for (size_t i = 0; i < row_count; ++i) {
+        uint16_t row = start_row + i;
+        uint16_t value = (uint16_t)(data[2u * i] | (((2u * i) + 1u < count_of_bytes) ? (data[(2u * i) + 1u] << 8) : 0u));
+
+        // The same row, written on its own
+        memcpy(g_rom_otp, image, NUM_OTP_ROWS * sizeof(uint32_t));
+        bool expected_ok = saferotp_write_single_value_ecc(row, value);
+
+        memcpy(g_rom_otp, after, sizeof(after));
+        all_ok = all_ok && is_ok_status(status[i]);
+        if (expected_ok) {
+            ++g_rows_written;
+            uint16_t read_back = 0u;
+            uint8_t read_status = 0xFFu;
+            if (!saferotp_read_data_ecc_ext(row, &read_back, sizeof(read_back), &read_status) || (read_back != value)) {
+                report("row that can be written does not read back as the requested value", op, i);
+            } else if (status[i] != read_status) {
+                report("status of a written row differs from the read status", op, i);
+            }
+            continue;
+        }
+        if (after[row] != image[row]) {
+            report("row that cannot be written was changed", op, i);
+        }
+        if ((image[row] & 0xFF000000u) != 0u) {
+            ++g_rows_io_error;
+            if (status[i] != SAFEROTP_ROW_STATUS_IO_ERROR) {
+                report("unreadable row is not IO_ERROR", op, i);
+            }
+        } else if (row == g_dropped_row) {
+            ++g_rows_io_error;
+            if ((status[i] != SAFEROTP_ROW_STATUS_IO_ERROR) && (status[i] != SAFEROTP_ROW_STATUS_WRITE_INCOMPATIBLE)) {
+                report("row whose write was dropped is not IO_ERROR (or WRITE_INCOMPATIBLE)", op, i);
+            }
+        } else {
+            ++g_rows_incompatible;
+            if (status[i] != SAFEROTP_ROW_STATUS_WRITE_INCOMPATIBLE) {
+                report("incompatible row is not WRITE_INCOMPATIBLE", op, i);
+            }
+        }
+    }
+    for (size_t i = row_count; i < xMAX_WRITE_ROWS; ++i) {
+        if (status[i] != 0xFFu) {
+            report("status written beyond the end of the range", op, i);
+            break;
+        }
+    }
+    if (result != all_ok) {
+        report("return value does not match the row statuses", op, 0u);
+    }
+    for (uint32_t row = 0u; row < NUM_OTP_ROWS; ++row) {
+        if (((row < start_row) || (row >= (start_row + row_count))) && (after[row] != image[row])) {
+            report("row outside the range was changed", op, 0u);
+            break;
+        }
+    }
+}
+// Ten blank rows, except one incompatible and one unreadable row, with an odd byte count
+static void check_fixed_range(void) {
+    static uint32_t image[NUM_OTP_ROWS];
+    uint8_t data[19];
+    for (size_t i = 0; i < sizeof(data); ++i) {
+        data[i] = (uint8_t)(0xA5u ^ (i * 0x1Du));
+    }
+    memset(image, 0, sizeof(image));
+    image[0x203u] = saferotp_calculate_ecc((uint16_t)((data[6] | (data[7] << 8)) ^ 0x0101u)); // a different value, which cannot be overwritten
+    image[0x206u] = 0xFFFFFFFFu;
+    memcpy(g_rom_otp, image, sizeof(image));
+    uint8_t status[10];
+    if (saferotp_write_data_ecc_ext(0x200u, data, sizeof(data), status)) {
+        report("range with an incompatible and an unreadable row was written", 0u, 0u);
+    }
+    for (size_t i = 0; i < 10u; ++i) {
+        uint8_t expected = (i == 3u) ? SAFEROTP_ROW_STATUS_WRITE_INCOMPATIBLE :
+                           (i == 6u) ? SAFEROTP_ROW_STATUS_IO_ERROR : SAFEROTP_ROW_STATUS_OK;
+        if (status[i] != expected) {
+            report("unexpected row status for the fixed range", 0u, i);
+        }
+        uint16_t read_back;
+        if ((expected == SAFEROTP_ROW_STATUS_OK) &&
+            (!saferotp_read_single_value_ecc(0x200u + i, &read_back) || (read_back != (data[2u * i] | ((i < 9u) ? (data[(2u * i) + 1u] << 8) : 0u))))) {
+            report("writable row of the fixed range does not read back", 0u, i);
+        }
+    }
+    if ((g_rom_otp[0x203u] != image[0x203u]) || (g_rom_otp[0x206u] != image[0x206u])) {
+        report("row of the fixed range that cannot be written was changed", 0u, 0u);
+    }
+}
+// Zero bytes: nothing to do, so success, without touching the OTP or the status buffer
+static void check_zero_bytes(void) {
+    uint8_t data[2] = { 0x12u, 0x34u };
+    uint8_t status[2] = { 0xFFu, 0xFFu };
+    memset(g_rom_otp, 0, sizeof(g_rom_otp));
+    if (!saferotp_write_data_ecc_ext(0x200u, data, 0u, status)) {
+        report("write of zero bytes failed", 0u, 0u);
+    }
+    if ((status[0] != 0xFFu) || (status[1] != 0xFFu)) {
+        report("write of zero bytes wrote a row status", 0u, 0u);
+    }
+    for (uint32_t row = 0u; row < NUM_OTP_ROWS; ++row) {
+        if (g_rom_otp[row] != 0u) {
+            report("write of zero bytes burned fuses", 0u, 0u);
+            break;
+        }
+    }
+}
+
+int main(void) {
+    static uint32_t image[NUM_OTP_ROWS];
+    static uint16_t values[NUM_OTP_ROWS];
+    uint8_t data[2u * xMAX_WRITE_ROWS];
+
+    check_fixed_range();
+    check_zero_bytes();
+    for (uint32_t op = 0u; op < xOPERATIONS; ++op) {
+        random_image(image, values);
+        uint16_t start_row;
+        size_t count_of_bytes = random_write(image, values, &start_row, data);
+        g_dropped_row = xNO_DROPPED_ROW;
+        if ((next_random() % 8u) == 0u) {
+            g_dropped_row = start_row + (next_random() % ((count_of_bytes + 1u) / 2u));
+        }
+        check_write(image, start_row, data, count_of_bytes, op);
+    }
+    g_dropped_row = xNO_DROPPED_ROW;
+    printf("%" PRIu32 " rows written, %" PRIu32 " incompatible, %" PRIu32 " unreadable or dropped\n",
+        g_rows_written, g_rows_incompatible, g_rows_io_error);
+    printf("%" PRIu32 " mismatches\n", g_mismatches);
+    return (g_mismatches == 0u) ? 0 : 1;
+}
@@ -0,0 +1,166 @@
+// Checks the ECC_RS erasure-coded blobs (saferotp_write_data_ecc_rs() /
+// saferotp_read_data_ecc_rs()) using a fake bootrom.  For every count of parity rows
+// (1..8), random blobs (including odd byte counts) are written to blank OTP, then:
+//   * up to `parity_rows` random rows (data or parity) are erased, either as unreadable
+//     rows or as rows with an uncorrectable (double-bit) error, and the blob must still
+//     read back byte-exact;
+//   * `parity_rows + 1` erased rows must fail to read;
+//   * with fewer than `parity_rows` erasures, a readable row replaced by a different
+//     valid ECC codeword must be rejected by the spare parity.
+// Returns non-zero on any mismatch.
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <inttypes.h>
+#include "pico/bootrom.h"
+#include "saferotp.h"
+
+#define xBLOBS_PER_PARITY_COUNT   2000u
+#define xCASES_PER_BLOB           8u
+#define xMAX_PARITY_ROWS          8u
+#define xMAX_BLOB_ROWS            NUM_OTP_PAGE_ROWS
+#define xMAX_REPORTED_MISMATCHES  8u
+#define xBLOB_START_ROW           0x140u // page aligned
+
+#pragma region    // Fake bootrom
+static uint32_t g_rom_otp[NUM_OTP_ROWS];
+
+// Reads fail if any row is unreadable (top byte set); writes OR bits, as the fuses would.
+int rom_func_otp_access(uint8_t* buf, uint32_t buf_len, otp_cmd_t cmd) {
+    uint32_t row = cmd.flags & OTP_CMD_ROW_BITS;
+    uint32_t row_count = buf_len / sizeof(uint32_t);
+    if ((row + row_count) > NUM_OTP_ROWS) {
+        return BOOTROM_ERROR_NOT_PERMITTED;
+    }
+    for (uint32_t i = 0u; i < row_count; ++i) {
+        if ((g_rom_otp[row + i] & 0xFF000000u) != 0u) {
+            return BOOTROM_ERROR_NOT_PERMITTED;
+        }
+    }
+    if ((cmd.flags & OTP_CMD_WRITE_BITS) == 0u) {
+        memcpy(buf, &g_rom_otp[row], buf_len);
+        return BOOTROM_OK;
+    }
+    for (uint32_t i = 0u; i < row_count; ++i) {
+        uint32_t value;
+        memcpy(&value, &buf[i * sizeof(uint32_t)], sizeof(uint32_t));
+        g_rom_otp[row + i] |= value;
+    }
+    return BOOTROM_OK;
+}
+void SaferOtp_WaitForKey_impl(void) {
+}
+#pragma endregion // Fake bootrom
+
+static uint32_t g_rng = 0x5EED1234u;
+static uint32_t next_random(void) {
+    // xorshift32
+    g_rng ^= g_rng << 13;
+    g_rng ^= g_rng >> 17;
+    g_rng ^= g_rng << 5;
+    return g_rng;
+}
+
+static uint32_t g_mismatches = 0u;
+static void report(const char* what, uint8_t parity_rows, uint32_t blob) {
+    if (g_mismatches < xMAX_REPORTED_MISMATCHES) {
+        printf("%d parity rows, blob %" PRIu32 ": %s\n", parity_rows, blob, what);
+    }
+    ++g_mismatches;
+}
+// Marks `count` distinct rows of the blob as erased
+static void choose_rows(bool* chosen, size_t row_count, size_t count) {
+    memset(chosen, 0, row_count * sizeof(bool));
+    for (size_t n = 0u; n < count; ) {
+        size_t i = next_random() % row_count;
+        if (!chosen[i]) {
+            chosen[i] = true;
+            ++n;
+        }
+    }
+}
+// Either unreadable, or an ECC row with a double-bit (uncorrectable) error
+static uint32_t erased_row(uint32_t raw) {
+    if ((next_random() & 1u) != 0u) {
+        return 0xFFFFFFFFu;
+    }
+    uint32_t a = next_random() % 22u;
+    uint32_t b = (a + 1u + (next_random() % 21u)) % 22u;
+    return raw ^ (1u << a) ^ (1u << b);
+}
+
+int main(void) {
+    static uint32_t written[NUM_OTP_ROWS];
+    uint8_t data[2u * xMAX_BLOB_ROWS];
+    uint8_t read_back[2u * xMAX_BLOB_ROWS];
+    bool erased[xMAX_BLOB_ROWS];
+    uint32_t rebuilt = 0u;
+    uint32_t detected = 0u;
+
+    for (uint8_t parity_rows = 1u; parity_rows <= xMAX_PARITY_ROWS; ++parity_rows) {
+        for (uint32_t blob = 0u; blob < xBLOBS_PER_PARITY_COUNT; ++blob) {
+            size_t count_of_bytes = 1u + (next_random() % (2u * (xMAX_BLOB_ROWS - parity_rows)));
+            size_t row_count = ((count_of_bytes + 1u) / 2u) + parity_rows;
+            for (size_t i = 0u; i < count_of_bytes; ++i) {
+                data[i] = (uint8_t)next_random();
+            }
+            memset(g_rom_otp, 0, sizeof(g_rom_otp));
+            if (!saferotp_write_data_ecc_rs(xBLOB_START_ROW, data, count_of_bytes, parity_rows)) {
+                report("write to blank OTP failed", parity_rows, blob);
+                continue;
+            }
+            memcpy(written, g_rom_otp, sizeof(written));
+
+            for (uint32_t c = 0u; c < xCASES_PER_BLOB; ++c) {
+                // 1. Up to `parity_rows` erasures are rebuilt exactly
+                size_t erasures = (row_count > parity_rows) ? (next_random() % (parity_rows + 1u)) : 0u;
+                choose_rows(erased, row_count, erasures);
+                memcpy(g_rom_otp, written, sizeof(g_rom_otp));
+                for (size_t i = 0u; i < row_count; ++i) {
+                    if (erased[i]) {
+                        g_rom_otp[xBLOB_START_ROW + i] = erased_row(written[xBLOB_START_ROW + i]);
+                    }
+                }
+                memset(read_back, 0, sizeof(read_back));
+                if (!saferotp_read_data_ecc_rs(xBLOB_START_ROW, read_back, count_of_bytes, parity_rows) ||
+                    (memcmp(read_back, data, count_of_bytes) != 0)) {
+                    report("blob with at most parity_rows erasures was not rebuilt exactly", parity_rows, blob);
+                } else {
+                    ++rebuilt;
+                }
+
+                // 2. With a spare parity row, a different valid codeword in any readable row is rejected
+                if (erasures < parity_rows) {
+                    size_t i;
+                    do {
+                        i = next_random() % row_count;
+                    } while (erased[i]);
+                    uint32_t original = saferotp_decode_raw(written[xBLOB_START_ROW + i]);
+                    uint16_t other = (uint16_t)(original ^ (1u + (next_random() % 0xFFFFu)));
+                    g_rom_otp[xBLOB_START_ROW + i] = saferotp_calculate_ecc(other);
+                    if (saferotp_read_data_ecc_rs(xBLOB_START_ROW, read_back, count_of_bytes, parity_rows)) {
+                        report("row swapped for a different valid codeword was not detected", parity_rows, blob);
+                    } else {
+                        ++detected;
+                    }
+                }
+
+                // 3. One erasure more than the parity rows always fails
+                choose_rows(erased, row_count, parity_rows + 1u);
+                memcpy(g_rom_otp, written, sizeof(g_rom_otp));
+                for (size_t i = 0u; i < row_count; ++i) {
+                    if (erased[i]) {
+                        g_rom_otp[xBLOB_START_ROW + i] = erased_row(written[xBLOB_START_ROW + i]);
+                    }
+                }
+                if (saferotp_read_data_ecc_rs(xBLOB_START_ROW, read_back, count_of_bytes, parity_rows)) {
+                    report("blob with parity_rows + 1 erasures was read", parity_rows, blob);
+                }
+            }
+        }
+    }
+    printf("%" PRIu32 " rebuilt, %" PRIu32 " swapped rows detected\n", rebuilt, detected);
+    printf("%" PRIu32 " mismatches\n", g_mismatches);
+    return (g_mismatches == 0u) ? 0 : 1;
+}
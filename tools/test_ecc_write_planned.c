@@ -0,0 +1,161 @@
+// Checks the planned bulk ECC write behind saferotp_write_data_ecc() against writing
+// the same rows one at a time with saferotp_write_single_value_ecc(), using a fake
+// bootrom.  Each operation starts from a random OTP image (blank rows, ECC rows, ECC
+// rows with a corrected bit flip, stray bits, and unreadable rows), and writes a random
+// range of up to three pages of rows (including odd byte counts).  For every operation:
+//   * the return values must match;
+//   * if the bulk write is rejected, the OTP image must be unchanged;
+//   * if it succeeds, every row must read back as the requested value.
+// Returns non-zero on any mismatch.
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <inttypes.h>
+#include "pico/bootrom.h"
+#include "saferotp.h"
+
+#define xOPERATIONS               160000u
+#define xMAX_WRITE_ROWS           150u // spans up to three pages
+#define xMAX_REPORTED_MISMATCHES  8u
+#define xIMAGE_BASE_ROW           0x100u
+#define xIMAGE_ROWS               0x200u
+
+#pragma region    // Fake bootrom
+static uint32_t g_rom_otp[NUM_OTP_ROWS];
+
+// Reads fail if any row is unreadable (top byte set); writes OR bits, as the fuses would.
+int rom_func_otp_access(uint8_t* buf, uint32_t buf_len, otp_cmd_t cmd) {
+    uint32_t row = cmd.flags & OTP_CMD_ROW_BITS;
+    uint32_t row_count = buf_len / sizeof(uint32_t);
+    if ((row + row_count) > NUM_OTP_ROWS) {
+        return BOOTROM_ERROR_NOT_PERMITTED;
+    }
+    for (uint32_t i = 0u; i < row_count; ++i) {
+        if ((g_rom_otp[row + i] & 0xFF000000u) != 0u) {
+            return BOOTROM_ERROR_NOT_PERMITTED;
+        }
+    }
+    if ((cmd.flags & OTP_CMD_WRITE_BITS) == 0u) {
+        memcpy(buf, &g_rom_otp[row], buf_len);
+        return BOOTROM_OK;
+    }
+    for (uint32_t i = 0u; i < row_count; ++i) {
+        uint32_t value;
+        memcpy(&value, &buf[i * sizeof(uint32_t)], sizeof(uint32_t));
+        g_rom_otp[row + i] |= value;
+    }
+    return BOOTROM_OK;
+}
+void SaferOtp_WaitForKey_impl(void) {
+}
+#pragma endregion // Fake bootrom
+
+#pragma region    // Random images and writes
+static uint32_t g_rng = 0x9E3779B9u;
+static uint32_t next_random(void) {
+    // xorshift32
+    g_rng ^= g_rng << 13;
+    g_rng ^= g_rng >> 17;
+    g_rng ^= g_rng << 5;
+    return g_rng;
+}
+// Mostly blank rows, so that a fair share of the writes can succeed
+static void random_image(uint32_t image[NUM_OTP_ROWS], uint16_t values[NUM_OTP_ROWS]) {
+    memset(image, 0, NUM_OTP_ROWS * sizeof(uint32_t));
+    for (uint32_t row = xIMAGE_BASE_ROW; row < (xIMAGE_BASE_ROW + xIMAGE_ROWS); ++row) {
+        values[row] = (uint16_t)next_random();
+        switch (next_random() % 40u) {
+            case 0: case 1: case 2: case 3:
+                image[row] = saferotp_calculate_ecc(values[row]);                                    break;
+            case 4: case 5:
+                image[row] = saferotp_calculate_ecc(values[row]) ^ (1u << (next_random() % 22u));    break;
+            case 6:
+                image[row] = 1u << (next_random() % 24u); /* stray bit */                            break;
+            case 7:
+                image[row] = 0xFFFFFFFFu; /* unreadable */                                           break;
+            default:
+                image[row] = 0u;                                                                     break;
+        }
+    }
+}
+// Values for the rows of the write: usually the value already stored (or a random
+// value for a blank row), occasionally a random value, which may not be writable.
+static size_t random_write(const uint32_t image[NUM_OTP_ROWS], const uint16_t values[NUM_OTP_ROWS], uint16_t* out_start_row, uint8_t* out_data) {
+    size_t row_count = 1u + (next_random() % (((next_random() % 4u) != 0u) ? 8u : xMAX_WRITE_ROWS));
+    uint16_t start_row = (uint16_t)(xIMAGE_BASE_ROW + (next_random() % (xIMAGE_ROWS - xMAX_WRITE_ROWS)));
+    for (size_t i = 0; i < row_count; ++i) {
+        uint16_t value = (uint16_t)next_random();
+        if ((image[start_row + i] != 0u) && ((next_random() % 16u) != 0u)) {
+            value = values[start_row + i];
+        }
+        out_data[(2u * i) + 0u] = (uint8_t)value;
+        out_data[(2u * i) + 1u] = (uint8_t)(value >> 8);
+    }
+    size_t count_of_bytes = 2u * row_count;
+    if ((next_random() & 1u) != 0u) {
+        // odd byte count: the final row is written with a zero high byte
+        --count_of_bytes;
+        out_data[count_of_bytes] = 0u;
+    }
+    *out_start_row = start_row;
+    return count_of_bytes;
+}
+#pragma endregion // Random images and writes
+
+static uint32_t g_mismatches = 0u;
+static void report(const char* what, uint32_t op) {
+    if (g_mismatches < xMAX_REPORTED_MISMATCHES) {
+        printf("operation %" PRIu32 ": %s\n", op, what);
+    }
+    ++g_mismatches;
+}
+
+int main(void) {
+    static uint32_t image[NUM_OTP_ROWS];
+    static uint16_t values[NUM_OTP_ROWS];
+    uint8_t data[2u * xMAX_WRITE_ROWS];
+    uint32_t written = 0u;
+    uint32_t rejected = 0u;
+
+    for (uint32_t op = 0u; op < xOPERATIONS; ++op) {
+        random_image(image, values);
+        uint16_t start_row;
+        size_t count_of_bytes = random_write(image, values, &start_row, data);
+        size_t row_count = (count_of_bytes + 1u) / 2u;
+
+        // 1. One row at a time, stopping at the first failure
+        memcpy(g_rom_otp, image, sizeof(image));
+        bool expected = true;
+        for (size_t i = 0; expected && (i < row_count); ++i) {
+            uint16_t value = (uint16_t)(data[2u * i] | (data[(2u * i) + 1u] << 8));
+            expected = saferotp_write_single_value_ecc(start_row + i, value);
+        }
+
+        // 2. Planned bulk write
+        memcpy(g_rom_otp, image, sizeof(image));
+        bool result = saferotp_write_data_ecc(start_row, data, count_of_bytes);
+        if (result != expected) {
+            report(result ? "bulk write succeeded, but a row-at-a-time write failed" : "bulk write failed, but row-at-a-time writes succeeded", op);
+        }
+        if (!result) {
+            ++rejected;
+            if (memcmp(g_rom_otp, image, sizeof(image)) != 0) {
+                report("bulk write was rejected, but changed the OTP image", op);
+            }
+            continue;
+        }
+        ++written;
+        for (size_t i = 0; i < row_count; ++i) {
+            uint16_t value = (uint16_t)(data[2u * i] | (data[(2u * i) + 1u] << 8));
+            uint16_t read_back = 0u;
+            if (!saferotp_read_single_value_ecc(start_row + i, &read_back) || (read_back != value)) {
+                report("row written by the bulk write does not read back as the requested value", op);
+                break;
+            }
+        }
+    }
+    printf("%" PRIu32 " written, %" PRIu32 " rejected\n", written, rejected);
+    printf("%" PRIu32 " mismatches\n", g_mismatches);
+    return (g_mismatches == 0u) ? 0 : 1;
+}
@@ -0,0 +1,271 @@
+// Checks saferotp_readv() / saferotp_writev() directly, using a fake bootrom.
+//   * Reads: each round starts from a random OTP image (blank, ECC, BYTE3X and RBIT
+//     rows, stray bits, and unreadable rows), and reads random descriptors of every
+//     encoding, in random order, crowded into a small span of rows so that many of them
+//     overlap.  Each descriptor's status must be OK exactly when the single-range read
+//     function for its encoding succeeds, and then its data must match.
+//   * Writes: random descriptors are written to a random image.  When any descriptors
+//     overlap, exactly the overlapping ones must be INVALID, the others NOT_ATTEMPTED,
+//     and the OTP image must be unchanged.  A fixed case checks the same for a pair of
+//     overlapping descriptors between two valid ones.
+// Returns non-zero on any mismatch.
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <inttypes.h>
+#include "pico/bootrom.h"
+#include "saferotp.h"
+
+#define xROUNDS                   20000u
+#define xMAX_DESCRIPTORS          8u
+#define xMAX_DESCRIPTOR_BYTES     64u
+#define xMAX_REPORTED_MISMATCHES  8u
+#define xIMAGE_BASE_ROW           0x100u
+#define xIMAGE_ROWS               0x200u
+#define xSPAN_ROWS                0x60u // descriptors start within this many rows, so they often overlap
+
+#pragma region    // Fake bootrom
+static uint32_t g_rom_otp[NUM_OTP_ROWS];
+
+// Reads fail if any row is unreadable (top byte set); writes OR bits, as the fuses would.
+int rom_func_otp_access(uint8_t* buf, uint32_t buf_len, otp_cmd_t cmd) {
+    uint32_t row = cmd.flags & OTP_CMD_ROW_BITS;
+    uint32_t row_count = buf_len / sizeof(uint32_t);
+    if ((row + row_count) > NUM_OTP_ROWS) {
+        return BOOTROM_ERROR_NOT_PERMITTED;
+    }
+    for (uint32_t i = 0u; i < row_count; ++i) {
+        if ((g_rom_otp[row + i] & 0xFF000000u) != 0u) {
+            return BOOTROM_ERROR_NOT_PERMITTED;
+        }
+    }
+    if ((cmd.flags & OTP_CMD_WRITE_BITS) == 0u) {
+        memcpy(buf, &g_rom_otp[row], buf_len);
+        return BOOTROM_OK;
+    }
+    for (uint32_t i = 0u; i < row_count; ++i) {
+        uint32_t value;
+        memcpy(&value, &buf[i * sizeof(uint32_t)], sizeof(uint32_t));
+        g_rom_otp[row + i] |= value;
+    }
+    return BOOTROM_OK;
+}
+void SaferOtp_WaitForKey_impl(void) {
+}
+#pragma endregion // Fake bootrom
+
+#pragma region    // Random images and descriptors
+static uint32_t g_rng = 0x1F2E3D4Cu;
+static uint32_t next_random(void) {
+    // xorshift32
+    g_rng ^= g_rng << 13;
+    g_rng ^= g_rng >> 17;
+    g_rng ^= g_rng << 5;
+    return g_rng;
+}
+static void random_image(uint32_t image[NUM_OTP_ROWS]) {
+    memset(image, 0, NUM_OTP_ROWS * sizeof(uint32_t));
+    for (uint32_t row = xIMAGE_BASE_ROW; row < (xIMAGE_BASE_ROW + xIMAGE_ROWS); ++row) {
+        uint32_t value = next_random() & next_random() & 0x00FFFFFFu;
+        switch (next_random() % 12u) {
+            case 0: case 1: image[row] = saferotp_calculate_ecc((uint16_t)value);     break;
+            case 2: case 3: image[row] = ((value & 0xFFu) * 0x010101u);               break;
+            case 4:         image[row] = value;                                       break;
+            case 5:         image[row] = 1u << (next_random() % 24u);                 break;
+            case 6:         image[row] = 0xFFFFFFFFu; /* unreadable */                break;
+            default:        image[row] = 0u;                                          break;
+        }
+    }
+    // Runs of rows holding the same value suit the RBIT3 / RBIT8 descriptors
+    for (uint32_t n = 0u; n < 8u; ++n) {
+        uint32_t row = xIMAGE_BASE_ROW + (next_random() % (xIMAGE_ROWS - 24u));
+        uint32_t value = next_random() & next_random() & 0x00FFFFFFu;
+        for (uint32_t i = 0u; i < 24u; ++i) {
+            if (image[row + i] != 0xFFFFFFFFu) {
+                image[row + i] = value;
+            }
+        }
+    }
+}
+static void random_descriptor(SAFEROTP_IOV* v, uint8_t* buffer, bool for_write) {
+    uint8_t encoding = (uint8_t)(next_random() % 5u);
+    size_t units = 1u + (next_random() % 12u);
+    size_t bytes;
+    if (encoding == SAFEROTP_IOV_ENCODING_ECC) {
+        bytes = (units * 2u) - (next_random() & 1u); // odd byte counts are allowed
+    } else if (encoding == SAFEROTP_IOV_ENCODING_BYTE3X) {
+        bytes = units;
+    } else {
+        if ((encoding == SAFEROTP_IOV_ENCODING_RBIT8) && (units > 6u)) {
+            units = 6u;
+        }
+        bytes = units * sizeof(uint32_t);
+    }
+    memset(buffer, 0, xMAX_DESCRIPTOR_BYTES);
+    if (for_write) {
+        for (size_t i = 0; i < bytes; ++i) {
+            buffer[i] = (uint8_t)(next_random() & next_random());
+        }
+        if ((encoding != SAFEROTP_IOV_ENCODING_ECC) && (encoding != SAFEROTP_IOV_ENCODING_BYTE3X)) {
+            for (size_t i = 3u; i < bytes; i += 4u) {
+                buffer[i] = 0u; // 24-bit values
+            }
+        }
+    }
+    v->buffer = buffer;
+    v->count_of_bytes = bytes;
+    v->start_row = (uint16_t)(xIMAGE_BASE_ROW + (next_random() % xSPAN_ROWS));
+    v->encoding = encoding;
+    v->status = 0xFFu;
+}
+static size_t descriptor_rows(const SAFEROTP_IOV* v) {
+    switch (v->encoding) {
+        case SAFEROTP_IOV_ENCODING_ECC:    return (v->count_of_bytes + 1u) / 2u;
+        case SAFEROTP_IOV_ENCODING_BYTE3X: return v->count_of_bytes;
+        case SAFEROTP_IOV_ENCODING_RBIT3:  return (v->count_of_bytes / sizeof(uint32_t)) * 3u;
+        case SAFEROTP_IOV_ENCODING_RBIT8:  return (v->count_of_bytes / sizeof(uint32_t)) * 8u;
+        default:                           return v->count_of_bytes / sizeof(uint32_t);
+    }
+}
+static bool descriptors_overlap(const SAFEROTP_IOV* a, const SAFEROTP_IOV* b) {
+    return (a->start_row < (b->start_row + descriptor_rows(b))) && (b->start_row < (a->start_row + descriptor_rows(a)));
+}
+// The single-range read function for the descriptor's encoding
+static bool read_single_range(const SAFEROTP_IOV* v, void* out) {
+    switch (v->encoding) {
+        case SAFEROTP_IOV_ENCODING_RAW:    return saferotp_read_data_raw_unsafe(v->start_row, out, v->count_of_bytes);
+        case SAFEROTP_IOV_ENCODING_ECC:    return saferotp_read_data_ecc(v->start_row, out, v->count_of_bytes);
+        case SAFEROTP_IOV_ENCODING_BYTE3X: return saferotp_read_data_byte3x(v->start_row, out, v->count_of_bytes);
+        case SAFEROTP_IOV_ENCODING_RBIT3:  return saferotp_read_data_rbit3(v->start_row, out, v->count_of_bytes);
+        case SAFEROTP_IOV_ENCODING_RBIT8:  return saferotp_read_data_rbit8(v->start_row, out, v->count_of_bytes);
+        default:                           return false;
+    }
+}
+#pragma endregion // Random images and descriptors
+
+static uint32_t g_mismatches = 0u;
+static void report(const char* what, uint32_t round, size_t index) {
+    if (g_mismatches < xMAX_REPORTED_MISMATCHES) {
+        printf("round %" PRIu32 " descriptor %zu: %s\n", round, index, what);
+    }
+    ++g_mismatches;
+}
+
+static uint8_t g_buffers[xMAX_DESCRIPTORS][xMAX_DESCRIPTOR_BYTES];
+static uint32_t g_overlapping_reads = 0u;
+static uint32_t g_failed_reads = 0u;
+static uint32_t g_rejected_writes = 0u;
+
+static void check_readv(const uint32_t image[NUM_OTP_ROWS], uint32_t round) {
+    SAFEROTP_IOV iov[xMAX_DESCRIPTORS];
+    size_t count = 1u + (next_random() % xMAX_DESCRIPTORS);
+    for (size_t i = 0; i < count; ++i) {
+        random_descriptor(&iov[i], g_buffers[i], false);
+    }
+    for (size_t i = 1; i < count; ++i) {
+        if (descriptors_overlap(&iov[0], &iov[i])) {
+            ++g_overlapping_reads;
+            break;
+        }
+    }
+    memcpy(g_rom_otp, image, NUM_OTP_ROWS * sizeof(uint32_t));
+    bool result = saferotp_readv(iov, count);
+    bool all_ok = true;
+    for (size_t i = 0; i < count; ++i) {
+        uint8_t expected[xMAX_DESCRIPTOR_BYTES] = {0u};
+        bool expected_ok = read_single_range(&iov[i], expected);
+        all_ok = all_ok && expected_ok;
+        if (!expected_ok) {
+            ++g_failed_reads;
+            if (iov[i].status != SAFEROTP_IOV_STATUS_READ_FAILED) {
+                report("status is not READ_FAILED, but the single-range read failed", round, i);
+            }
+        } else if (iov[i].status != SAFEROTP_IOV_STATUS_OK) {
+            report("status is not OK, but the single-range read succeeded", round, i);
+        } else if (memcmp(iov[i].buffer, expected, iov[i].count_of_bytes) != 0) {
+            report("data differs from the single-range read", round, i);
+        }
+    }
+    if (result != all_ok) {
+        report("return value does not match the descriptor statuses", round, 0u);
+    }
+}
+static void check_writev_overlaps(const uint32_t image[NUM_OTP_ROWS], uint32_t round) {
+    SAFEROTP_IOV iov[xMAX_DESCRIPTORS];
+    size_t count = 2u + (next_random() % (xMAX_DESCRIPTORS - 1u));
+    for (size_t i = 0; i < count; ++i) {
+        random_descriptor(&iov[i], g_buffers[i], true);
+    }
+    bool overlaps[xMAX_DESCRIPTORS] = {false};
+    bool any_overlap = false;
+    for (size_t i = 0; i < count; ++i) {
+        for (size_t j = i + 1u; j < count; ++j) {
+            if (descriptors_overlap(&iov[i], &iov[j])) {
+                overlaps[i] = overlaps[j] = any_overlap = true;
+            }
+        }
+    }
+    if (!any_overlap) {
+        return; // only writes with overlapping descriptors are checked here
+    }
+    ++g_rejected_writes;
+    memcpy(g_rom_otp, image, NUM_OTP_ROWS * sizeof(uint32_t));
+    if (saferotp_writev(iov, count)) {
+        report("writev with overlapping descriptors succeeded", round, 0u);
+    }
+    for (size_t i = 0; i < count; ++i) {
+        uint8_t expected = overlaps[i] ? SAFEROTP_IOV_STATUS_INVALID : SAFEROTP_IOV_STATUS_NOT_ATTEMPTED;
+        if (iov[i].status != expected) {
+            report(overlaps[i] ? "overlapping descriptor is not INVALID" : "other descriptor is not NOT_ATTEMPTED", round, i);
+        }
+    }
+    if (memcmp(g_rom_otp, image, NUM_OTP_ROWS * sizeof(uint32_t)) != 0) {
+        report("writev with overlapping descriptors changed the OTP image", round, 0u);
+    }
+}
+// Two valid descriptors, with an overlapping pair between them, on blank OTP
+static void check_writev_fixed_overlap(void) {
+    uint16_t ecc_values[4] = { 0x1234u, 0x5678u, 0x9ABCu, 0xDEF0u };
+    uint8_t  byte3x_values[4] = { 0x11u, 0x22u, 0x33u, 0x44u };
+    uint32_t raw_values[2] = { 0x00ABCDEFu, 0x00123456u };
+    uint32_t rbit3_value = 0x00C0FFEEu;
+    SAFEROTP_IOV iov[4] = {
+        { .buffer = ecc_values,    .count_of_bytes = sizeof(ecc_values),    .start_row = 0x200u, .encoding = SAFEROTP_IOV_ENCODING_ECC    },
+        { .buffer = byte3x_values, .count_of_bytes = sizeof(byte3x_values), .start_row = 0x210u, .encoding = SAFEROTP_IOV_ENCODING_BYTE3X },
+        { .buffer = raw_values,    .count_of_bytes = sizeof(raw_values),    .start_row = 0x213u, .encoding = SAFEROTP_IOV_ENCODING_RAW    },
+        { .buffer = &rbit3_value,  .count_of_bytes = sizeof(rbit3_value),   .start_row = 0x220u, .encoding = SAFEROTP_IOV_ENCODING_RBIT3  },
+    };
+    static const uint8_t expected[4] = {
+        SAFEROTP_IOV_STATUS_NOT_ATTEMPTED, SAFEROTP_IOV_STATUS_INVALID, SAFEROTP_IOV_STATUS_INVALID, SAFEROTP_IOV_STATUS_NOT_ATTEMPTED,
+    };
+    memset(g_rom_otp, 0, sizeof(g_rom_otp));
+    if (saferotp_writev(iov, 4u)) {
+        report("writev with an overlapping pair succeeded", 0u, 0u);
+    }
+    for (size_t i = 0; i < 4u; ++i) {
+        if (iov[i].status != expected[i]) {
+            report("unexpected status for writev with an overlapping pair", 0u, i);
+        }
+    }
+    for (uint32_t row = 0u; row < NUM_OTP_ROWS; ++row) {
+        if (g_rom_otp[row] != 0u) {
+            report("writev with an overlapping pair burned fuses", 0u, 0u);
+            break;
+        }
+    }
+}
+
+int main(void) {
+    static uint32_t image[NUM_OTP_ROWS];
+    check_writev_fixed_overlap();
+    for (uint32_t round = 0u; round < xROUNDS; ++round) {
+        random_image(image);
+        check_readv(image, round);
+        check_writev_overlaps(image, round);
+    }
+    printf("%" PRIu32 " reads with overlapping descriptors, %" PRIu32 " failed descriptor reads, %" PRIu32 " overlapping writes rejected\n",
+        g_overlapping_reads, g_failed_reads, g_rejected_writes);
+    printf("%" PRIu32 " mismatches\n", g_mismatches);
+    return (g_mismatches == 0u) ? 0 : 1;
+}
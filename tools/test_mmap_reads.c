@@ -0,0 +1,166 @@
+// Checks the memory-mapped raw read backend (SAFEROTP_MMAP_RAW_READS) of saferotp_rw.c
+// against plain arrays standing in for the OTP data and the SW_LOCK registers.
+// Pages get random SW_LOCK values (R/W, R/O, no access, non-secure only) and random
+// PAGEn_LOCK1 rows (including a corrupted copy of the byte), and BOOTLOCK2 is refused
+// at random, as if another user held it.  For random ranges of rows:
+//   * mmap_read_raw_otp() succeeds exactly when every page of the range is readable
+//     and BOOTLOCK2 was free, and then matches the array;
+//   * hw_read_raw_otp_wrapper() falls back to the bootrom in every other case, and
+//     returns what the bootrom returns;
+//   * BOOTLOCK2 is always released.
+// Returns non-zero on any mismatch.
+//
+// saferotp_rw.c is included (rather than linked) to reach its static functions; the
+// SDK headers it needs come from host_stubs/.
+#include <stdint.h>
+#include "pico/bootrom.h"
+
+static uint32_t g_otp[NUM_OTP_ROWS];
+static uint32_t g_sw_lock[NUM_OTP_PAGES];
+#define SAFEROTP_MMAP_RAW_BASE     ((const volatile uint32_t*)g_otp)
+#define SAFEROTP_SW_LOCK_BASE      ((const volatile uint32_t*)g_sw_lock)
+#include "saferotp_rw.c"
+
+#include <stdio.h>
+#include <inttypes.h>
+
+static_assert(SAFEROTP_MMAP_RAW_READS, "build this test with SAFEROTP_MMAP_RAW_READS=1");
+
+#define xREADS                    200000u
+#define xMAX_READ_ROWS            130u // spans up to three pages
+#define xMAX_REPORTED_MISMATCHES  8u
+
+static uint32_t g_rng = 0x2468ACE1u;
+static uint32_t next_random(void) {
+    // xorshift32
+    g_rng ^= g_rng << 13;
+    g_rng ^= g_rng >> 17;
+    g_rng ^= g_rng << 5;
+    return g_rng;
+}
+
+#pragma region    // Model of the OTP permissions
+static bool lock_allows_read(uint32_t lock) {
+    return (lock & 0x3u) <= 0x1u; // secure R/W or R/O
+}
+static uint32_t page_lock1_row(uint32_t page) {
+    return 0xF81u + (2u * page);
+}
+static uint8_t page_lock1(uint32_t page) {
+    uint32_t raw = g_otp[page_lock1_row(page)];
+    uint8_t a = (uint8_t)raw, b = (uint8_t)(raw >> 8), c = (uint8_t)(raw >> 16);
+    return (uint8_t)((a & b) | (a & c) | (b & c));
+}
+// What the bootrom enforces for the rows of `page`
+static bool bootrom_can_read_page(uint32_t page) {
+    return lock_allows_read(g_sw_lock[page]) && lock_allows_read(page_lock1(page));
+}
+// The memory-mapped read also needs to read the page's PAGEn_LOCK1 row
+static bool mmap_can_read_page(uint32_t page) {
+    return bootrom_can_read_page(page) && lock_allows_read(g_sw_lock[page_lock1_row(page) / NUM_OTP_PAGE_ROWS]);
+}
+#pragma endregion // Model of the OTP permissions
+
+#pragma region    // Fake bootrom, and BOOTLOCK2 held elsewhere at random
+static uint32_t g_rom_calls = 0u;
+static bool g_lock_refused = false;
+
+int rom_func_otp_access(uint8_t* buf, uint32_t buf_len, otp_cmd_t cmd) {
+    ++g_rom_calls;
+    uint32_t row = cmd.flags & OTP_CMD_ROW_BITS;
+    uint32_t row_count = buf_len / sizeof(uint32_t);
+    if (((cmd.flags & OTP_CMD_WRITE_BITS) != 0u) || ((row + row_count) > NUM_OTP_ROWS)) {
+        return BOOTROM_ERROR_NOT_PERMITTED;
+    }
+    for (uint32_t i = 0u; i < row_count; ++i) {
+        if (!bootrom_can_read_page((row + i) / NUM_OTP_PAGE_ROWS)) {
+            return BOOTROM_ERROR_NOT_PERMITTED;
+        }
+    }
+    memcpy(buf, &g_otp[row], buf_len);
+    return BOOTROM_OK;
+}
+void SaferOtp_WaitForKey_impl(void) {
+}
+static bool refuse_one_in_ten(unsigned lock_num) {
+    (void)lock_num;
+    g_lock_refused = (next_random() % 10u) == 0u;
+    return g_lock_refused;
+}
+#pragma endregion // Fake bootrom, and BOOTLOCK2 held elsewhere at random
+
+static void random_otp(void) {
+    // SW_LOCK: R/W, R/O, NS only (secure no access, NS R/W), no access, secure reserved value
+    static const uint32_t sw_lock_values[] = { 0x0u, 0x0u, 0x0u, 0x0u, 0x0u, 0x0u, 0x0u, 0x0u, 0x0u, 0x1u, 0x1u, 0xDu, 0x3u, 0xFu, 0x2u, 0x3u };
+    for (uint32_t row = 0u; row < NUM_OTP_ROWS; ++row) {
+        g_otp[row] = next_random() & 0x00FFFFFFu;
+    }
+    for (uint32_t page = 0u; page < NUM_OTP_PAGES; ++page) {
+        g_sw_lock[page] = sw_lock_values[next_random() % 16u];
+    }
+    for (uint32_t page = 0u; page < NUM_OTP_PAGES; ++page) {
+        uint32_t lock_s = ((next_random() % 3u) == 0u) ? (next_random() % 4u) : 0u;
+        uint32_t raw = lock_s * 0x010101u;
+        if ((next_random() % 4u) == 0u) {
+            raw ^= 0x3u << (8u * (next_random() % 3u)); // one corrupted copy, outvoted by the other two
+        }
+        g_otp[page_lock1_row(page)] = raw;
+    }
+}
+
+int main(void) {
+    uint32_t mismatches = 0u;
+    uint32_t mmap_reads = 0u;
+    uint32_t fallbacks = 0u;
+    uint32_t refusals = 0u;
+    g_host_bootrom_lock_refuse = refuse_one_in_ten;
+    for (uint32_t read = 0u; read < xREADS; ++read) {
+        if ((read % 1000u) == 0u) {
+            random_otp();
+        }
+        uint32_t row_count = 1u + (next_random() % (((next_random() % 4u) != 0u) ? 4u : xMAX_READ_ROWS));
+        uint16_t start_row = (uint16_t)(next_random() % (NUM_OTP_ROWS - row_count + 1u));
+        bool mmap_readable = true;
+        bool bootrom_readable = true;
+        for (uint32_t page = start_row / NUM_OTP_PAGE_ROWS; page <= (start_row + row_count - 1u) / NUM_OTP_PAGE_ROWS; ++page) {
+            mmap_readable = mmap_readable && mmap_can_read_page(page);
+            bootrom_readable = bootrom_readable && bootrom_can_read_page(page);
+        }
+        uint32_t buffer[xMAX_READ_ROWS];
+        bool match = true;
+
+        // 1. The memory-mapped read alone
+        g_lock_refused = false;
+        memset(buffer, 0, sizeof(buffer));
+        bool mmap_ok = mmap_read_raw_otp(start_row, buffer, row_count * sizeof(uint32_t));
+        bool mmap_expected = mmap_readable && !g_lock_refused;
+        match = match && (mmap_ok == mmap_expected);
+        match = match && (!mmap_ok || (memcmp(buffer, &g_otp[start_row], row_count * sizeof(uint32_t)) == 0));
+        match = match && !g_host_bootrom_lock_held[BOOTROM_LOCK_OTP];
+        refusals += g_lock_refused ? 1u : 0u;
+
+        // 2. The raw read wrapper, falling back to the bootrom
+        g_lock_refused = false;
+        memset(buffer, 0, sizeof(buffer));
+        uint32_t rom_calls = g_rom_calls;
+        bool ok = hw_read_raw_otp_wrapper(start_row, buffer, row_count * sizeof(uint32_t));
+        bool used_mmap = mmap_readable && !g_lock_refused;
+        match = match && (ok == (used_mmap || bootrom_readable));
+        match = match && (!ok || (memcmp(buffer, &g_otp[start_row], row_count * sizeof(uint32_t)) == 0));
+        match = match && ((g_rom_calls == rom_calls) == used_mmap);
+        match = match && !g_host_bootrom_lock_held[BOOTROM_LOCK_OTP];
+        mmap_reads += used_mmap ? 1u : 0u;
+        fallbacks += used_mmap ? 0u : 1u;
+
+        if (!match) {
+            if (mismatches < xMAX_REPORTED_MISMATCHES) {
+                printf("rows 0x%03x..0x%03" PRIx32 ": mmap %d (expected %d), wrapper %d, bootrom readable %d\n",
+                    start_row, start_row + row_count - 1u, mmap_ok, mmap_expected, ok, bootrom_readable);
+            }
+            ++mismatches;
+        }
+    }
+    printf("%" PRIu32 " memory-mapped reads, %" PRIu32 " bootrom fallbacks, %" PRIu32 " BOOTLOCK2 refusals\n", mmap_reads, fallbacks, refusals);
+    printf("%" PRIu32 " mismatches\n", mismatches);
+    return (mismatches == 0u) ? 0 : 1;
+}
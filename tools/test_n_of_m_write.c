@@ -0,0 +1,189 @@
+// Checks the minimal-burn N-of-M write planner (SAFEROTP_N_OF_M_WRITE_MARGIN) through
+// saferotp_write_data_rbit3() / saferotp_write_data_rbit8(), using a fake bootrom.
+// Built once with the default margin, and once with a margin of zero.
+// Each operation starts from a random OTP image, where each row of each group holds
+// nothing, part of the new value, part of the new value plus a stray bit, all of the
+// new value, or is unreadable.  For every operation:
+//   * the write succeeds exactly when every group votes (before the write) with no bit
+//     set that is not in the new value;
+//   * if the write fails, the OTP image is unchanged;
+//   * if it succeeds, each bit of the new value has max(existing, N + margin) votes,
+//     capped at the number of readable rows of its group; bits not in the new value,
+//     and unreadable rows, are unchanged; and the value reads back.
+// Returns non-zero on any mismatch.
+//
+// saferotp_rw.c is included (rather than linked) to reach vote_N_of_M() and the
+// configured margin; the SDK headers it needs come from host_stubs/.
+#include "saferotp_rw.c"
+
+#include <stdio.h>
+#include <stdint.h>
+#include <inttypes.h>
+
+#define xOPERATIONS               100000u
+#define xMAX_GROUPS               24u  // up to 192 rows of RBIT8, spanning several pages
+#define xMAX_REPORTED_MISMATCHES  8u
+#define xIMAGE_BASE_ROW           0x100u
+#define xIMAGE_ROWS               0x200u
+
+#pragma region    // Fake bootrom
+static uint32_t g_rom_otp[NUM_OTP_ROWS];
+
+// Reads fail if any row is unreadable (top byte set); writes OR bits, as the fuses would.
+int rom_func_otp_access(uint8_t* buf, uint32_t buf_len, otp_cmd_t cmd) {
+    uint32_t row = cmd.flags & OTP_CMD_ROW_BITS;
+    uint32_t row_count = buf_len / sizeof(uint32_t);
+    if ((row + row_count) > NUM_OTP_ROWS) {
+        return BOOTROM_ERROR_NOT_PERMITTED;
+    }
+    for (uint32_t i = 0u; i < row_count; ++i) {
+        if ((g_rom_otp[row + i] & 0xFF000000u) != 0u) {
+            return BOOTROM_ERROR_NOT_PERMITTED;
+        }
+    }
+    if ((cmd.flags & OTP_CMD_WRITE_BITS) == 0u) {
+        memcpy(buf, &g_rom_otp[row], buf_len);
+        return BOOTROM_OK;
+    }
+    for (uint32_t i = 0u; i < row_count; ++i) {
+        uint32_t value;
+        memcpy(&value, &buf[i * sizeof(uint32_t)], sizeof(uint32_t));
+        g_rom_otp[row + i] |= value;
+    }
+    return BOOTROM_OK;
+}
+void SaferOtp_WaitForKey_impl(void) {
+}
+#pragma endregion // Fake bootrom
+
+#pragma region    // Random images and values
+static uint32_t g_rng = 0x0BADC0DEu;
+static uint32_t next_random(void) {
+    // xorshift32
+    g_rng ^= g_rng << 13;
+    g_rng ^= g_rng >> 17;
+    g_rng ^= g_rng << 5;
+    return g_rng;
+}
+static uint32_t random_row(uint32_t new_value) {
+    switch (next_random() % 20u) {
+        case 0: case 1: case 2: case 3: case 4: case 5:
+            return new_value & next_random();
+        case 6:
+            return (new_value & next_random()) | (1u << (next_random() % 24u)); // may be a stray bit
+        case 7: case 8:
+            return new_value;
+        case 9:
+            return 0xFFFFFFFFu; // unreadable
+        default:
+            return 0u;
+    }
+}
+#pragma endregion // Random images and values
+
+static uint32_t g_mismatches = 0u;
+static void report(const char* what, uint8_t M, uint32_t op) {
+    if (g_mismatches < xMAX_REPORTED_MISMATCHES) {
+        printf("margin %d, %d rows per group, operation %" PRIu32 ": %s\n", SAFEROTP_N_OF_M_WRITE_MARGIN, M, op, what);
+    }
+    ++g_mismatches;
+}
+static uint_fast8_t count_votes(const uint32_t* rows, uint8_t M, uint_fast8_t bit) {
+    uint_fast8_t votes = 0u;
+    for (uint_fast8_t i = 0u; i < M; ++i) {
+        if (((rows[i] & 0xFF000000u) == 0u) && (((rows[i] >> bit) & 1u) != 0u)) {
+            ++votes;
+        }
+    }
+    return votes;
+}
+// Checks the group after a successful write, against the group before it
+static void check_group(uint8_t N, uint8_t M, uint32_t new_value, const uint32_t* before, const uint32_t* after, uint32_t op) {
+    uint_fast8_t readable_rows = 0u;
+    for (uint_fast8_t i = 0u; i < M; ++i) {
+        if ((before[i] & 0xFF000000u) != 0u) {
+            if (after[i] != before[i]) {
+                report("unreadable row was changed", M, op);
+            }
+            continue;
+        }
+        ++readable_rows;
+        if (((after[i] ^ before[i]) & ~new_value) != 0u) {
+            report("bit not in the new value was burned", M, op);
+        }
+    }
+    uint_fast8_t target = N + SAFEROTP_N_OF_M_WRITE_MARGIN;
+    if (target > readable_rows) {
+        target = readable_rows;
+    }
+    for (uint_fast8_t bit = 0u; bit < 24u; ++bit) {
+        if (((new_value >> bit) & 1u) == 0u) {
+            continue;
+        }
+        uint_fast8_t existing = count_votes(before, M, bit);
+        uint_fast8_t expected = (existing > target) ? existing : target;
+        if (count_votes(after, M, bit) != expected) {
+            report("bit of the new value does not have max(existing, N + margin) votes", M, op);
+            return;
+        }
+    }
+}
+static void run_operation(uint8_t N, uint8_t M, uint32_t op, uint32_t* written, uint32_t* rejected) {
+    static uint32_t image[NUM_OTP_ROWS];
+    uint32_t values[xMAX_GROUPS];
+    uint32_t read_back[xMAX_GROUPS];
+    size_t group_count = 1u + (next_random() % (((next_random() % 4u) != 0u) ? 3u : xMAX_GROUPS));
+    uint16_t start_row = (uint16_t)(xIMAGE_BASE_ROW + (next_random() % (xIMAGE_ROWS - (xMAX_GROUPS * MAX_M_VALUE))));
+
+    // 1. Random image, and whether each group can be written
+    memset(image, 0, sizeof(image));
+    bool writable = true;
+    for (size_t g = 0; g < group_count; ++g) {
+        values[g] = next_random() & next_random() & 0x00FFFFFFu;
+        uint32_t * rows = &image[start_row + (g * M)];
+        for (uint_fast8_t i = 0u; i < M; ++i) {
+            rows[i] = random_row(values[g]);
+        }
+        uint32_t voted;
+        if (!vote_N_of_M(start_row + (g * M), N, M, rows, &voted) || ((voted & ~values[g]) != 0u)) {
+            writable = false;
+        }
+    }
+
+    // 2. Write, and check the result
+    memcpy(g_rom_otp, image, sizeof(image));
+    bool result = (M == 3u) ? saferotp_write_data_rbit3(start_row, values, group_count * sizeof(uint32_t))
+                            : saferotp_write_data_rbit8(start_row, values, group_count * sizeof(uint32_t));
+    if (result != writable) {
+        report(result ? "write of an unwritable group succeeded" : "write of writable groups failed", M, op);
+    }
+    if (!result) {
+        ++(*rejected);
+        if (memcmp(g_rom_otp, image, sizeof(image)) != 0) {
+            report("failed write changed the OTP image", M, op);
+        }
+        return;
+    }
+    ++(*written);
+    for (size_t g = 0; g < group_count; ++g) {
+        size_t row = start_row + (g * M);
+        check_group(N, M, values[g], &image[row], &g_rom_otp[row], op);
+    }
+    bool read_ok = (M == 3u) ? saferotp_read_data_rbit3(start_row, read_back, group_count * sizeof(uint32_t))
+                             : saferotp_read_data_rbit8(start_row, read_back, group_count * sizeof(uint32_t));
+    if (!read_ok || (memcmp(read_back, values, group_count * sizeof(uint32_t)) != 0)) {
+        report("written value does not read back", M, op);
+    }
+}
+
+int main(void) {
+    uint32_t written = 0u;
+    uint32_t rejected = 0u;
+    for (uint32_t op = 0u; op < xOPERATIONS; ++op) {
+        run_operation(2u, 3u, op, &written, &rejected);
+        run_operation(3u, 8u, op, &written, &rejected);
+    }
+    printf("margin %d: %" PRIu32 " written, %" PRIu32 " rejected\n", SAFEROTP_N_OF_M_WRITE_MARGIN, written, rejected);
+    printf("%" PRIu32 " mismatches\n", g_mismatches);
+    return ((g_mismatches == 0u) && (written != 0u)) ? 0 : 1;
+}
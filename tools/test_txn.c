@@ -0,0 +1,290 @@
+// Checks the all-or-nothing behaviour of transactions (saferotp_txn_add() /
+// saferotp_txn_commit()), using a fake bootrom.  Each round stages several operations
+// of random encodings, on blank rows that do not overlap (some adjacent, added in
+// random order), surrounded by random rows.  In about half the rounds, one unit of one
+// operation cannot be written (an unreadable ECC row, or existing bits that are not in
+// the new value).  For every round:
+//   * if an operation cannot be written, commit returns false, that operation is
+//     WRITE_IMPOSSIBLE, every other operation is NOT_ATTEMPTED, and the OTP image is
+//     unchanged;
+//   * otherwise, commit returns true, every operation is OK and reads back, and no row
+//     outside the operations is changed.
+// Also checks that a failed add (an unknown encoding) stops the whole commit, with
+// every operation NOT_ATTEMPTED and nothing burned.  Returns non-zero on any mismatch.
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <inttypes.h>
+#include "pico/bootrom.h"
+#include "saferotp.h"
+
+#define xROUNDS                   50000u
+#define xMAX_OPS                  8u
+#define xMAX_OP_BYTES             64u
+#define xMAX_REPORTED_MISMATCHES  8u
+#define xIMAGE_BASE_ROW           0x100u
+#define xIMAGE_ROWS               0x200u
+#define xNEW_BIT_MASK             0x7Fu // new data never sets the top bit of a byte, so existing top bits conflict
+
+#pragma region    // Fake bootrom
+static uint32_t g_rom_otp[NUM_OTP_ROWS];
+
+// Reads fail if any row is unreadable (top byte set); writes OR bits, as the fuses would.
+int rom_func_otp_access(uint8_t* buf, uint32_t buf_len, otp_cmd_t cmd) {
+    uint32_t row = cmd.flags & OTP_CMD_ROW_BITS;
+    uint32_t row_count = buf_len / sizeof(uint32_t);
+    if ((row + row_count) > NUM_OTP_ROWS) {
+        return BOOTROM_ERROR_NOT_PERMITTED;
+    }
+    for (uint32_t i = 0u; i < row_count; ++i) {
+        if ((g_rom_otp[row + i] & 0xFF000000u) != 0u) {
+            return BOOTROM_ERROR_NOT_PERMITTED;
+        }
+    }
+    if ((cmd.flags & OTP_CMD_WRITE_BITS) == 0u) {
+        memcpy(buf, &g_rom_otp[row], buf_len);
+        return BOOTROM_OK;
+    }
+    for (uint32_t i = 0u; i < row_count; ++i) {
+        uint32_t value;
+        memcpy(&value, &buf[i * sizeof(uint32_t)], sizeof(uint32_t));
+        g_rom_otp[row + i] |= value;
+    }
+    return BOOTROM_OK;
+}
+void SaferOtp_WaitForKey_impl(void) {
+}
+#pragma endregion // Fake bootrom
+
+#pragma region    // Random operations
+static uint32_t g_rng = 0x7A11C0DEu;
+static uint32_t next_random(void) {
+    // xorshift32
+    g_rng ^= g_rng << 13;
+    g_rng ^= g_rng >> 17;
+    g_rng ^= g_rng << 5;
+    return g_rng;
+}
+static size_t rows_per_unit(uint8_t encoding) {
+    switch (encoding) {
+        case SAFEROTP_IOV_ENCODING_RBIT3: return 3u;
+        case SAFEROTP_IOV_ENCODING_RBIT8: return 8u;
+        default:                          return 1u;
+    }
+}
+static size_t op_rows(const SAFEROTP_IOV* v) {
+    switch (v->encoding) {
+        case SAFEROTP_IOV_ENCODING_ECC:    return (v->count_of_bytes + 1u) / 2u;
+        case SAFEROTP_IOV_ENCODING_BYTE3X: return v->count_of_bytes;
+        default:                           return (v->count_of_bytes / sizeof(uint32_t)) * rows_per_unit(v->encoding);
+    }
+}
+// Random encoding and data (any bit for ECC; no top bit of a byte otherwise), at `start_row`
+static void random_op(SAFEROTP_IOV* v, uint8_t* buffer, uint16_t start_row) {
+    uint8_t encoding = (uint8_t)(next_random() % 5u);
+    size_t units = 1u + (next_random() % ((encoding == SAFEROTP_IOV_ENCODING_RBIT8) ? 6u : 12u));
+    size_t bytes;
+    if (encoding == SAFEROTP_IOV_ENCODING_ECC) {
+        bytes = (units * 2u) - (next_random() & 1u); // odd byte counts are allowed
+    } else if (encoding == SAFEROTP_IOV_ENCODING_BYTE3X) {
+        bytes = units;
+    } else {
+        bytes = units * sizeof(uint32_t);
+    }
+    memset(buffer, 0, xMAX_OP_BYTES);
+    for (size_t i = 0; i < bytes; ++i) {
+        buffer[i] = (uint8_t)next_random();
+        if (encoding != SAFEROTP_IOV_ENCODING_ECC) {
+            buffer[i] &= xNEW_BIT_MASK;
+        }
+        if ((encoding != SAFEROTP_IOV_ENCODING_ECC) && (encoding != SAFEROTP_IOV_ENCODING_BYTE3X) && ((i % 4u) == 3u)) {
+            buffer[i] = 0u; // 24-bit values
+        }
+    }
+    v->buffer = buffer;
+    v->count_of_bytes = bytes;
+    v->start_row = start_row;
+    v->encoding = encoding;
+    v->status = 0xFFu;
+}
+// Makes one random unit of the operation impossible to write
+static void make_unwritable(uint32_t image[NUM_OTP_ROWS], const SAFEROTP_IOV* v) {
+    size_t unit_rows = rows_per_unit(v->encoding);
+    size_t unit = next_random() % (op_rows(v) / unit_rows);
+    uint32_t * rows = &image[v->start_row + (unit * unit_rows)];
+    if (v->encoding == SAFEROTP_IOV_ENCODING_ECC) {
+        rows[0] = 0xFFFFFFFFu; // unreadable
+        return;
+    }
+    // Every row of the unit holds (and so votes for) a bit that the new data never sets
+    uint32_t conflict = (uint32_t)(~xNEW_BIT_MASK & 0xFFu) << (8u * (next_random() % 3u));
+    if (v->encoding == SAFEROTP_IOV_ENCODING_BYTE3X) {
+        conflict = (~xNEW_BIT_MASK & 0xFFu) * 0x010101u;
+    }
+    for (size_t i = 0; i < unit_rows; ++i) {
+        rows[i] = conflict;
+    }
+}
+// The single-range read function for the operation's encoding
+static bool read_single_range(const SAFEROTP_IOV* v, void* out) {
+    switch (v->encoding) {
+        case SAFEROTP_IOV_ENCODING_RAW:    return saferotp_read_data_raw_unsafe(v->start_row, out, v->count_of_bytes);
+        case SAFEROTP_IOV_ENCODING_ECC:    return saferotp_read_data_ecc(v->start_row, out, v->count_of_bytes);
+        case SAFEROTP_IOV_ENCODING_BYTE3X: return saferotp_read_data_byte3x(v->start_row, out, v->count_of_bytes);
+        case SAFEROTP_IOV_ENCODING_RBIT3:  return saferotp_read_data_rbit3(v->start_row, out, v->count_of_bytes);
+        case SAFEROTP_IOV_ENCODING_RBIT8:  return saferotp_read_data_rbit8(v->start_row, out, v->count_of_bytes);
+        default:                           return false;
+    }
+}
+#pragma endregion // Random operations
+
+static uint32_t g_mismatches = 0u;
+static void report(const char* what, uint32_t round, size_t index) {
+    if (g_mismatches < xMAX_REPORTED_MISMATCHES) {
+        printf("round %" PRIu32 " operation %zu: %s\n", round, index, what);
+    }
+    ++g_mismatches;
+}
+
+static uint8_t g_buffers[xMAX_OPS][xMAX_OP_BYTES];
+
+// Returns true if the transaction was expected to commit (and did)
+static bool run_round(uint32_t round) {
+    static uint32_t image[NUM_OTP_ROWS];
+    SAFEROTP_IOV ops[xMAX_OPS];
+    bool in_op[NUM_OTP_ROWS] = {false};
+    size_t count = 1u + (next_random() % xMAX_OPS);
+
+    // 1. Random rows, then blank operations laid out in row order, some of them adjacent
+    memset(image, 0, sizeof(image));
+    for (uint32_t row = xIMAGE_BASE_ROW; row < (xIMAGE_BASE_ROW + xIMAGE_ROWS); ++row) {
+        switch (next_random() % 4u) {
+            case 0:  image[row] = next_random() & 0x00FFFFFFu; break;
+            case 1:  image[row] = 0xFFFFFFFFu; /* unreadable */ break;
+            default: image[row] = 0u;                           break;
+        }
+    }
+    uint16_t row = xIMAGE_BASE_ROW + (uint16_t)(next_random() % 8u);
+    for (size_t i = 0; i < count; ++i) {
+        random_op(&ops[i], g_buffers[i], row);
+        for (size_t r = 0; r < op_rows(&ops[i]); ++r) {
+            image[row + r] = 0u;
+            in_op[row + r] = true;
+        }
+        row += (uint16_t)(op_rows(&ops[i]) + (next_random() % 3u));
+    }
+    size_t bad = xMAX_OPS;
+    if ((next_random() & 1u) != 0u) {
+        bad = next_random() % count;
+        make_unwritable(image, &ops[bad]);
+    }
+
+    // 2. Stage the operations in random order, and commit
+    size_t order[xMAX_OPS];
+    for (size_t i = 0; i < count; ++i) {
+        order[i] = i;
+    }
+    for (size_t i = count - 1u; i > 0u; --i) {
+        size_t j = next_random() % (i + 1u);
+        size_t t = order[i];
+        order[i] = order[j];
+        order[j] = t;
+    }
+    SAFEROTP_TXN txn;
+    saferotp_txn_begin(&txn);
+    for (size_t i = 0; i < count; ++i) {
+        const SAFEROTP_IOV * v = &ops[order[i]];
+        if (!saferotp_txn_add(&txn, v->encoding, v->start_row, v->buffer, v->count_of_bytes)) {
+            report("adding a valid operation failed", round, order[i]);
+        }
+    }
+    memcpy(g_rom_otp, image, sizeof(image));
+    bool result = saferotp_txn_commit(&txn);
+
+    // 3. All or nothing
+    if (bad < count) {
+        if (result) {
+            report("commit with an unwritable operation succeeded", round, bad);
+        }
+        for (size_t i = 0; i < count; ++i) {
+            uint8_t expected = (order[i] == bad) ? SAFEROTP_IOV_STATUS_WRITE_IMPOSSIBLE : SAFEROTP_IOV_STATUS_NOT_ATTEMPTED;
+            if (txn.ops[i].status != expected) {
+                report((order[i] == bad) ? "unwritable operation is not WRITE_IMPOSSIBLE" : "other operation is not NOT_ATTEMPTED", round, order[i]);
+            }
+        }
+        if (memcmp(g_rom_otp, image, sizeof(image)) != 0) {
+            report("failed commit changed the OTP image", round, bad);
+        }
+        return false;
+    }
+    if (!result) {
+        report("commit of writable operations failed", round, 0u);
+        return false;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        uint8_t read_back[xMAX_OP_BYTES] = {0u};
+        if (txn.ops[i].status != SAFEROTP_IOV_STATUS_OK) {
+            report("committed operation is not OK", round, order[i]);
+        }
+        if (!read_single_range(&ops[i], read_back) || (memcmp(read_back, ops[i].buffer, ops[i].count_of_bytes) != 0)) {
+            report("committed operation does not read back", round, i);
+        }
+    }
+    for (uint32_t r = 0u; r < NUM_OTP_ROWS; ++r) {
+        if (!in_op[r] && (g_rom_otp[r] != image[r])) {
+            report("commit changed a row outside the operations", round, 0u);
+            break;
+        }
+    }
+    return true;
+}
+// Valid operations around one with an unknown encoding, on blank OTP
+static void check_failed_add(void) {
+    uint16_t ecc_values[4] = { 0x1234u, 0x5678u, 0x9ABCu, 0xDEF0u };
+    uint8_t  byte3x_values[4] = { 0x11u, 0x22u, 0x33u, 0x44u };
+    uint32_t rbit3_value = 0x00C0FFEEu;
+    SAFEROTP_TXN txn;
+    saferotp_txn_begin(&txn);
+    memset(g_rom_otp, 0, sizeof(g_rom_otp));
+    if (!saferotp_txn_add(&txn, SAFEROTP_IOV_ENCODING_ECC, 0x200u, ecc_values, sizeof(ecc_values))) {
+        report("adding a valid operation failed", 0u, 0u);
+    }
+    if (saferotp_txn_add(&txn, 0x7Fu, 0x208u, byte3x_values, sizeof(byte3x_values))) {
+        report("adding an operation with an unknown encoding succeeded", 0u, 1u);
+    }
+    if (!saferotp_txn_add(&txn, SAFEROTP_IOV_ENCODING_BYTE3X, 0x210u, byte3x_values, sizeof(byte3x_values)) ||
+        !saferotp_txn_add(&txn, SAFEROTP_IOV_ENCODING_RBIT3, 0x220u, &rbit3_value, sizeof(rbit3_value))) {
+        report("adding a valid operation failed", 0u, 2u);
+    }
+    if (saferotp_txn_commit(&txn)) {
+        report("commit after a failed add succeeded", 0u, 0u);
+    }
+    for (size_t i = 0; i < txn.op_count; ++i) {
+        if (txn.ops[i].status != SAFEROTP_IOV_STATUS_NOT_ATTEMPTED) {
+            report("operation is not NOT_ATTEMPTED after a failed add", 0u, i);
+        }
+    }
+    for (uint32_t r = 0u; r < NUM_OTP_ROWS; ++r) {
+        if (g_rom_otp[r] != 0u) {
+            report("commit after a failed add burned fuses", 0u, 0u);
+            break;
+        }
+    }
+}
+
+int main(void) {
+    uint32_t committed = 0u;
+    uint32_t rejected = 0u;
+    check_failed_add();
+    for (uint32_t round = 0u; round < xROUNDS; ++round) {
+        if (run_round(round)) {
+            ++committed;
+        } else {
+            ++rejected;
+        }
+    }
+    printf("%" PRIu32 " committed, %" PRIu32 " rejected\n", committed, rejected);
+    printf("%" PRIu32 " mismatches\n", g_mismatches);
+    return (g_mismatches == 0u) ? 0 : 1;
+}
@@ -0,0 +1,146 @@
+// Compares the carry-save vote counters of vote_N_of_M() (saferotp_rw.c) against plain
+// per-bit counting, for every supported N-of-M (1 <= N <= M <= 8), every pattern of
+// failed reads, and every column of votes (the M bits at one bit position) placed at
+// each bit position over several backgrounds.  Also checks the counter itself for every
+// count and threshold.  Returns non-zero on any mismatch.
+//
+// saferotp_rw.c is included (rather than linked) to reach its static functions; the
+// SDK headers it needs come from host_stubs/.
+#include "saferotp_rw.c"
+
+#include <stdio.h>
+#include <stdint.h>
+#include <inttypes.h>
+
+#define xMAX_REPORTED_MISMATCHES 8u
+
+// Never called: this test does not touch OTP rows
+int rom_func_otp_access(uint8_t* buf, uint32_t buf_len, otp_cmd_t cmd) {
+    (void)buf; (void)buf_len; (void)cmd;
+    return BOOTROM_ERROR_NOT_PERMITTED;
+}
+void SaferOtp_WaitForKey_impl(void) {
+}
+
+// The original per-bit algorithm: count the votes for each of the 24 bits separately
+static bool ref_vote_N_of_M(uint8_t N, uint8_t M, const uint32_t* v, uint32_t* out_data) {
+    uint_fast8_t votes[24] = {0u};
+    uint_fast8_t successful_reads = 0u;
+    uint_fast8_t failed_reads = 0u;
+    for (size_t i = 0; i < M; ++i) {
+        if ((v[i] & 0xFF000000u) != 0u) {
+            ++failed_reads;
+            continue;
+        }
+        ++successful_reads;
+        for (uint_fast8_t bit = 0u; bit < 24u; ++bit) {
+            votes[bit] += (v[i] >> bit) & 1u;
+        }
+    }
+    if (successful_reads < N) {
+        return false;
+    }
+    uint32_t result = 0u;
+    for (uint_fast8_t bit = 0u; bit < 24u; ++bit) {
+        if (votes[bit] >= N) {
+            result |= 1u << bit;
+        } else if (failed_reads >= N - votes[bit]) {
+            return false;
+        }
+    }
+    *out_data = result;
+    return true;
+}
+
+static uint32_t check_vote_counter(void) {
+    uint32_t mismatches = 0u;
+    // bit position `b` receives `b % 16` votes, so every count 0..15 is present
+    VOTE_COUNTER votes = { .count = {0u} };
+    for (uint_fast8_t round = 0u; round < 15u; ++round) {
+        uint32_t w = 0u;
+        for (uint_fast8_t bit = 0u; bit < 32u; ++bit) {
+            if ((bit % 16u) > round) {
+                w |= 1u << bit;
+            }
+        }
+        vote_counter_add(&votes, w);
+    }
+    for (uint_fast8_t bit = 0u; bit < 32u; ++bit) {
+        if (vote_counter_get(&votes, bit) != (bit % 16u)) {
+            printf("counter bit %u: expected %u votes, got %u\n", (unsigned)bit, (unsigned)(bit % 16u), (unsigned)vote_counter_get(&votes, bit));
+            ++mismatches;
+        }
+    }
+    for (uint_fast8_t k = 0u; k < 16u; ++k) {
+        uint32_t expected = 0u;
+        for (uint_fast8_t bit = 0u; bit < 32u; ++bit) {
+            if ((bit % 16u) >= k) {
+                expected |= 1u << bit;
+            }
+        }
+        uint32_t actual = vote_counter_at_least(&votes, k);
+        if (expected != actual) {
+            printf("counter at least %u: expected 0x%08" PRIx32 ", got 0x%08" PRIx32 "\n", (unsigned)k, expected, actual);
+            ++mismatches;
+        }
+    }
+    return mismatches;
+}
+
+int main(void) {
+    uint32_t mismatches = check_vote_counter();
+    uint64_t cases = 0u;
+
+    for (uint8_t M = 1u; M <= MAX_M_VALUE; ++M) {
+        for (uint8_t N = 1u; N <= M; ++N) {
+            for (uint32_t failed_mask = 0u; failed_mask < (1u << M); ++failed_mask) {
+                for (uint32_t column = 0u; column < (1u << M); ++column) {
+                    for (uint_fast8_t position = 0u; position < 24u; ++position) {
+                        for (uint_fast8_t background = 0u; background < 3u; ++background) {
+                            uint32_t v[MAX_M_VALUE];
+                            for (uint_fast8_t i = 0u; i < M; ++i) {
+                                uint32_t other_bits =
+                                    (background == 0u) ? 0u :
+                                    (background == 1u) ? 0x00FFFFFFu :
+                                                         (0x005A5A5Au >> i);
+                                other_bits &= ~(1u << position);
+                                if ((failed_mask >> i) & 1u) {
+                                    // both values seen for unreadable rows
+                                    v[i] = (i & 1u) ? 0xFFFFFFFFu : 0x7F000000u;
+                                } else {
+                                    v[i] = other_bits | (((column >> i) & 1u) << position);
+                                }
+                            }
+                            uint32_t expected = 0u;
+                            uint32_t actual = 0u;
+                            bool expected_ok = ref_vote_N_of_M(N, M, v, &expected);
+                            bool actual_ok = vote_N_of_M(0u, N, M, v, &actual);
+                            ++cases;
+                            bool match = (expected_ok == actual_ok) &&
+                                         (actual_ok ? (expected == actual) : (actual == 0xFFFFFFFFu));
+                            if (!match) {
+                                if (mismatches < xMAX_REPORTED_MISMATCHES) {
+                                    printf("%u-of-%u failed 0x%02" PRIx32 " column 0x%02" PRIx32 " bit %u background %u: expected %d 0x%06" PRIx32 ", got %d 0x%08" PRIx32 "\n",
+                                        N, M, failed_mask, column, (unsigned)position, (unsigned)background,
+                                        expected_ok, expected, actual_ok, actual);
+                                }
+                                ++mismatches;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+    for (uint8_t M = 0u; M <= MAX_M_VALUE + 1u; ++M) {
+        for (uint8_t N = 0u; N <= M + 1u; ++N) {
+            bool expected = (N >= 1u) && (N <= M) && (M <= MAX_M_VALUE);
+            if (is_supported_N_of_M(N, M) != expected) {
+                printf("is_supported_N_of_M(%u, %u): expected %d\n", N, M, expected);
+                ++mismatches;
+            }
+        }
+    }
+    printf("%" PRIu64 " cases, %" PRIu32 " mismatches\n", cases, mismatches);
+    return (mismatches == 0u) ? 0 : 1;
+}